@@ -6,6 +6,7 @@
 #include "Misc/Paths.h"
 #include "ShaderCore.h"
 #include "SMAATextures.h"
+#include "SMAAPipelineCache.h"
 #include "SceneViewExtension.h" 
 
 #define LOCTEXT_NAMESPACE "FSMAAModule"
@@ -37,6 +38,12 @@ void FSMAAModule::OnPostEngineInit()
     bExtensionCreated = true;
 
     UE_LOG(LogTemp, Warning, TEXT("SMAA: Scene view extension registered"));
+
+    // Create every SMAA pipeline now so the first SMAA frame doesn't hitch
+    ENQUEUE_RENDER_COMMAND(SMAAPrecachePipelines)([](FRHICommandListImmediate& RHICmdList)
+    {
+        SMAAPipelineCache::PrecachePipelines();
+    });
 }
 
 void FSMAAModule::ShutdownModule()
@@ -0,0 +1,153 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SMAABatchCommandlet.h"
+#include "SMAACpu.h"
+#include "SMAASettings.h"
+#include "HAL/FileManager.h"
+#include "ImageCore.h"
+#include "ImageUtils.h"
+#include "Misc/Paths.h"
+#include "Tasks/Task.h"
+
+namespace
+{
+    // One frame moving through the decode -> AA -> encode pipeline
+    struct FSMAABatchFrame
+    {
+        FString InputPath;
+        FString OutputPath;
+
+        // Decoded pixels, anti-aliased in place and released after encoding
+        FImage Image;
+
+        // Format the frame is written back in
+        ERawImageFormat::Type SourceFormat = ERawImageFormat::RGBA32F;
+        EGammaSpace SourceGammaSpace = EGammaSpace::Linear;
+
+        bool bFailed = false;
+    };
+
+    void GatherInputFiles(const FString& InputDir, TArray<FString>& OutFiles)
+    {
+        for (const TCHAR* Extension : { TEXT("*.png"), TEXT("*.exr") })
+        {
+            TArray<FString> Found;
+            IFileManager::Get().FindFiles(Found, *FPaths::Combine(InputDir, Extension), true, false);
+            OutFiles.Append(Found);
+        }
+
+        // Sequences are numbered, keep frame order stable
+        OutFiles.Sort();
+    }
+}
+
+USMAABatchCommandlet::USMAABatchCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 USMAABatchCommandlet::Main(const FString& Params)
+{
+    FString InputDir;
+    FString OutputDir;
+    if (!FParse::Value(*Params, TEXT("Input="), InputDir) || !FParse::Value(*Params, TEXT("Output="), OutputDir))
+    {
+        UE_LOG(LogTemp, Error, TEXT("SMAA Batch: Usage: -run=SMAABatch -Input=<Dir> -Output=<Dir> [-MaxInFlight=N]"));
+        return 1;
+    }
+
+    // Bounds memory: each in-flight frame holds one decoded RGBA32F image plus AA scratch
+    int32 MaxInFlight = FMath::Max(FTaskGraphInterface::Get().GetNumWorkerThreads(), 2);
+    FParse::Value(*Params, TEXT("MaxInFlight="), MaxInFlight);
+    MaxInFlight = FMath::Max(MaxInFlight, 1);
+
+    TArray<FString> Files;
+    GatherInputFiles(InputDir, Files);
+    if (Files.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SMAA Batch: No PNG/EXR files found in %s"), *InputDir);
+        return 0;
+    }
+
+    IFileManager::Get().MakeDirectory(*OutputDir, true);
+
+    const FSMAASettings Settings = FSMAASettings::GetRuntimeSettings();
+    std::atomic<int32> NumFailed{ 0 };
+
+    UE_LOG(LogTemp, Display, TEXT("SMAA Batch: Processing %d frames, %d in flight"), Files.Num(), MaxInFlight);
+
+    // Encode tasks of the frames currently alive, oldest first
+    TArray<UE::Tasks::FTask> InFlight;
+
+    for (const FString& File : Files)
+    {
+        // Producer blocks here until the oldest frame has been written
+        if (InFlight.Num() >= MaxInFlight)
+        {
+            InFlight[0].Wait();
+            InFlight.RemoveAt(0);
+        }
+
+        TSharedRef<FSMAABatchFrame, ESPMode::ThreadSafe> Frame = MakeShared<FSMAABatchFrame, ESPMode::ThreadSafe>();
+        Frame->InputPath = FPaths::Combine(InputDir, File);
+        Frame->OutputPath = FPaths::Combine(OutputDir, File);
+
+        UE::Tasks::FTask DecodeTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Frame]()
+        {
+            if (!FImageUtils::LoadImage(*Frame->InputPath, Frame->Image))
+            {
+                UE_LOG(LogTemp, Error, TEXT("SMAA Batch: Failed to decode %s"), *Frame->InputPath);
+                Frame->bFailed = true;
+                return;
+            }
+
+            Frame->SourceFormat = Frame->Image.Format;
+            Frame->SourceGammaSpace = Frame->Image.GammaSpace;
+            Frame->Image.ChangeFormat(ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+        });
+
+        UE::Tasks::FTask AATask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Frame, &Settings]()
+        {
+            if (Frame->bFailed)
+            {
+                return;
+            }
+
+            // Float sources (EXR) are scene-referred HDR
+            const bool bHDRInput = ERawImageFormat::IsHDR(Frame->SourceFormat);
+            SMAACpu::Process(Frame->Image, bHDRInput, Settings);
+        }, DecodeTask);
+
+        UE::Tasks::FTask EncodeTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Frame, &NumFailed]()
+        {
+            if (!Frame->bFailed)
+            {
+                Frame->Image.ChangeFormat(Frame->SourceFormat, Frame->SourceGammaSpace);
+                if (!FImageUtils::SaveImageByExtension(*Frame->OutputPath, Frame->Image))
+                {
+                    UE_LOG(LogTemp, Error, TEXT("SMAA Batch: Failed to encode %s"), *Frame->OutputPath);
+                    Frame->bFailed = true;
+                }
+            }
+
+            if (Frame->bFailed)
+            {
+                ++NumFailed;
+            }
+
+            // Release pixels now rather than when the last task reference goes away
+            Frame->Image = FImage();
+        }, AATask);
+
+        InFlight.Add(EncodeTask);
+    }
+
+    UE::Tasks::Wait(InFlight);
+
+    UE_LOG(LogTemp, Display, TEXT("SMAA Batch: Done, %d of %d frames failed"), NumFailed.load(), Files.Num());
+    return NumFailed.load() == 0 ? 0 : 1;
+}
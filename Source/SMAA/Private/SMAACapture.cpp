@@ -0,0 +1,308 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SMAACapture.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "ImageCore.h"
+#include "ImageUtils.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "RenderGraphBuilder.h"
+#include "RenderGraphUtils.h"
+#include "RHIGPUReadback.h"
+#include "SceneRendering.h"
+#include "Tasks/Task.h"
+
+namespace SMAACapture
+{
+    // Captured texture, tightly packed once the readback landed
+    struct FCapturedTexture
+    {
+        TUniquePtr<FRHIGPUTextureReadback> Readback;
+        FIntPoint Extent = FIntPoint::ZeroValue;
+        EPixelFormat Format = PF_Unknown;
+        TArray64<uint8> Pixels;
+    };
+
+    struct FFrame
+    {
+        uint32 FrameNumber = 0;
+        int32 ViewIndex = 0;
+
+        FCapturedTexture Edges;
+        FCapturedTexture BlendWeights;
+
+        // Start timestamp plus one per marked pass
+        TArray<FRenderQueryRHIRef> Timestamps;
+        TArray<FString> PassNames;
+        TArray<uint64> TimestampResults;
+    };
+
+    // Render thread state
+    static int32 GFramesRemaining = 0;
+    static uint32 GCurrentFrameNumber = MAX_uint32;
+    static int32 GCurrentViewIndex = 0;
+    static TArray<TUniquePtr<FFrame>> GPendingFrames;
+
+    static FAutoConsoleCommand CmdSMAACapture(
+        TEXT("r.SMAA.Capture"),
+        TEXT("Captures SMAA edges, blend weights, edge density histograms and pass timings of the next N frames (default 1)\n")
+        TEXT("Written to Saved/SMAA/Captures without stalling the renderer"),
+        FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+        {
+            const int32 NumFrames = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1;
+            ENQUEUE_RENDER_COMMAND(SMAARequestCapture)([NumFrames](FRHICommandListImmediate&)
+            {
+                GFramesRemaining = NumFrames;
+                GCurrentFrameNumber = MAX_uint32;
+            });
+            UE_LOG(LogTemp, Log, TEXT("SMAA: Capturing the next %d frame(s)"), NumFrames);
+        })
+    );
+
+    static FString GetCaptureDir()
+    {
+        return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SMAA"), TEXT("Captures"));
+    }
+
+    static void AddTimestamp(FRDGBuilder& GraphBuilder, FFrame& Frame, const TCHAR* PassName)
+    {
+        if (!GSupportsTimestampRenderQueries)
+        {
+            return;
+        }
+
+        FRenderQueryRHIRef Query = RHICreateRenderQuery(RQT_AbsoluteTime);
+        Frame.Timestamps.Add(Query);
+        Frame.PassNames.Add(PassName);
+
+        GraphBuilder.AddPass(
+            RDG_EVENT_NAME("SMAA Capture Timestamp"),
+            ERDGPassFlags::NeverCull,
+            [Query](FRHICommandListImmediate& RHICmdList)
+            {
+                RHICmdList.EndRenderQuery(Query);
+            });
+    }
+
+    static void EnqueueReadback(FRDGBuilder& GraphBuilder, FCapturedTexture& Texture, FRDGTextureRef SourceTexture)
+    {
+        Texture.Extent = SourceTexture->Desc.Extent;
+        Texture.Format = SourceTexture->Desc.Format;
+        Texture.Readback = MakeUnique<FRHIGPUTextureReadback>(TEXT("SMAA.CaptureReadback"));
+        AddEnqueueCopyPass(GraphBuilder, Texture.Readback.Get(), SourceTexture);
+    }
+
+    // Copies the readback into a tightly packed array, false while the GPU has not finished
+    static bool ResolveTexture(FCapturedTexture& Texture)
+    {
+        if (!Texture.Readback.IsValid() || Texture.Pixels.Num() > 0)
+        {
+            return true;
+        }
+        if (!Texture.Readback->IsReady())
+        {
+            return false;
+        }
+
+        const int64 BytesPerPixel = GPixelFormats[Texture.Format].BlockBytes;
+        const int64 RowBytes = Texture.Extent.X * BytesPerPixel;
+
+        int32 RowPitchInPixels = 0;
+        const uint8* Source = static_cast<const uint8*>(Texture.Readback->Lock(RowPitchInPixels));
+        Texture.Pixels.SetNumUninitialized(RowBytes * Texture.Extent.Y);
+        for (int32 Y = 0; Y < Texture.Extent.Y; ++Y)
+        {
+            FMemory::Memcpy(&Texture.Pixels[Y * RowBytes], Source + Y * RowPitchInPixels * BytesPerPixel, RowBytes);
+        }
+        Texture.Readback->Unlock();
+        Texture.Readback.Reset();
+        return true;
+    }
+
+    static bool ResolveTimestamps(FFrame& Frame)
+    {
+        Frame.TimestampResults.SetNumZeroed(Frame.Timestamps.Num());
+        for (int32 Index = 0; Index < Frame.Timestamps.Num(); ++Index)
+        {
+            if (!RHIGetRenderQueryResult(Frame.Timestamps[Index], Frame.TimestampResults[Index], false))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Left/top edge of a pixel, RGBA8 on desktop and packed R8 on the mobile path
+    static void DecodeEdges(const FCapturedTexture& Edges, int64 PixelIndex, bool& bOutLeft, bool& bOutTop)
+    {
+        if (Edges.Format == PF_R8)
+        {
+            const uint32 Bits = (Edges.Pixels[PixelIndex] * 4 + 127) / 255;
+            bOutLeft = (Bits & 2) != 0;
+            bOutTop = (Bits & 1) != 0;
+        }
+        else
+        {
+            bOutLeft = Edges.Pixels[PixelIndex * 4 + 0] > 127;
+            bOutTop = Edges.Pixels[PixelIndex * 4 + 1] > 127;
+        }
+    }
+
+    // Writer task: images, edge density histogram and timings
+    static void WriteFrame(const FFrame& Frame)
+    {
+        const FString BaseName = FPaths::Combine(GetCaptureDir(), FString::Printf(TEXT("Frame%u_View%d"), Frame.FrameNumber, Frame.ViewIndex));
+        IFileManager::Get().MakeDirectory(*GetCaptureDir(), true);
+
+        FString Report;
+        Report += FString::Printf(TEXT("Frame,%u\nView,%d\n"), Frame.FrameNumber, Frame.ViewIndex);
+
+        // Per pass GPU time (timestamps are in microseconds)
+        Report += TEXT("\nPass,Milliseconds\n");
+        for (int32 Index = 1; Index < Frame.TimestampResults.Num(); ++Index)
+        {
+            const double Milliseconds = double(Frame.TimestampResults[Index] - Frame.TimestampResults[Index - 1]) / 1000.0;
+            Report += FString::Printf(TEXT("%s,%.4f\n"), *Frame.PassNames[Index], Milliseconds);
+        }
+
+        const FCapturedTexture& Edges = Frame.Edges;
+        if (Edges.Pixels.Num() > 0)
+        {
+            const FIntPoint Extent = Edges.Extent;
+            FImage EdgeImage(Extent.X, Extent.Y, ERawImageFormat::BGRA8, EGammaSpace::Linear);
+            TArrayView64<FColor> EdgeColors = EdgeImage.AsBGRA8();
+
+            // Edge density per 16x16 tile, bucketed in tenths
+            const int32 TileSize = 16;
+            const FIntPoint TileCount = FIntPoint::DivideAndRoundUp(Extent, TileSize);
+            TArray<int32> TileEdgePixels;
+            TileEdgePixels.SetNumZeroed(TileCount.X * TileCount.Y);
+
+            int64 NumLeft = 0;
+            int64 NumTop = 0;
+            for (int32 Y = 0; Y < Extent.Y; ++Y)
+            {
+                for (int32 X = 0; X < Extent.X; ++X)
+                {
+                    const int64 PixelIndex = int64(Y) * Extent.X + X;
+                    bool bLeft = false;
+                    bool bTop = false;
+                    DecodeEdges(Edges, PixelIndex, bLeft, bTop);
+
+                    NumLeft += bLeft ? 1 : 0;
+                    NumTop += bTop ? 1 : 0;
+                    if (bLeft || bTop)
+                    {
+                        ++TileEdgePixels[(Y / TileSize) * TileCount.X + X / TileSize];
+                    }
+                    EdgeColors[PixelIndex] = FColor(bLeft ? 255 : 0, bTop ? 255 : 0, 0, 255);
+                }
+            }
+
+            int32 DensityHistogram[11] = {};
+            for (int32 TileIndex = 0; TileIndex < TileEdgePixels.Num(); ++TileIndex)
+            {
+                const int32 TileX = TileIndex % TileCount.X;
+                const int32 TileY = TileIndex / TileCount.X;
+                const int32 TilePixels = FMath::Min(TileSize, Extent.X - TileX * TileSize) * FMath::Min(TileSize, Extent.Y - TileY * TileSize);
+                ++DensityHistogram[FMath::Clamp(TileEdgePixels[TileIndex] * 10 / FMath::Max(TilePixels, 1), 0, 10)];
+            }
+
+            const double NumPixels = double(Extent.X) * Extent.Y;
+            Report += FString::Printf(TEXT("\nEdges,Pixels,Fraction\nLeft,%lld,%.5f\nTop,%lld,%.5f\n"), NumLeft, NumLeft / NumPixels, NumTop, NumTop / NumPixels);
+            Report += TEXT("\nTileEdgeDensity,Tiles\n");
+            for (int32 Bucket = 0; Bucket <= 10; ++Bucket)
+            {
+                Report += FString::Printf(TEXT("%d%%,%d\n"), Bucket * 10, DensityHistogram[Bucket]);
+            }
+
+            FImageUtils::SaveImageByExtension(*(BaseName + TEXT("_Edges.png")), EdgeImage);
+        }
+
+        const FCapturedTexture& BlendWeights = Frame.BlendWeights;
+        if (BlendWeights.Pixels.Num() > 0 && BlendWeights.Format == PF_FloatRGBA)
+        {
+            FImageView WeightView(BlendWeights.Pixels.GetData(), BlendWeights.Extent.X, BlendWeights.Extent.Y, ERawImageFormat::RGBA16F);
+            FImageUtils::SaveImageByExtension(*(BaseName + TEXT("_BlendWeights.exr")), WeightView);
+        }
+
+        FFileHelper::SaveStringToFile(Report, *(BaseName + TEXT("_Report.csv")));
+        UE_LOG(LogTemp, Log, TEXT("SMAA: Wrote capture %s"), *BaseName);
+    }
+
+    FFrame* BeginFrame(FRDGBuilder& GraphBuilder, const FViewInfo& View)
+    {
+        // A request covers every view of the next N frames
+        const uint32 FrameNumber = View.Family->FrameNumber;
+        if (FrameNumber != GCurrentFrameNumber)
+        {
+            if (GFramesRemaining <= 0)
+            {
+                return nullptr;
+            }
+            --GFramesRemaining;
+            GCurrentFrameNumber = FrameNumber;
+            GCurrentViewIndex = 0;
+        }
+
+        FFrame* Frame = new FFrame();
+        Frame->FrameNumber = FrameNumber;
+        Frame->ViewIndex = GCurrentViewIndex++;
+        AddTimestamp(GraphBuilder, *Frame, TEXT("Begin"));
+        return Frame;
+    }
+
+    void MarkPass(FRDGBuilder& GraphBuilder, FFrame* Frame, const TCHAR* PassName)
+    {
+        if (Frame)
+        {
+            AddTimestamp(GraphBuilder, *Frame, PassName);
+        }
+    }
+
+    void CaptureTextures(FRDGBuilder& GraphBuilder, FFrame* Frame, FRDGTextureRef EdgeTexture, FRDGTextureRef BlendWeightTexture)
+    {
+        if (!Frame)
+        {
+            return;
+        }
+
+        EnqueueReadback(GraphBuilder, Frame->Edges, EdgeTexture);
+        EnqueueReadback(GraphBuilder, Frame->BlendWeights, BlendWeightTexture);
+    }
+
+    void EndFrame(FFrame* Frame)
+    {
+        if (Frame)
+        {
+            GPendingFrames.Emplace(Frame);
+        }
+    }
+
+    void Tick_RenderThread()
+    {
+        check(IsInRenderingThread());
+
+        for (int32 Index = 0; Index < GPendingFrames.Num(); )
+        {
+            FFrame& Frame = *GPendingFrames[Index];
+            if (!ResolveTexture(Frame.Edges) || !ResolveTexture(Frame.BlendWeights) || !ResolveTimestamps(Frame))
+            {
+                ++Index;
+                continue;
+            }
+
+            // Encoding and histograms run off the render thread
+            TSharedRef<FFrame, ESPMode::ThreadSafe> Finished = MakeShareable(GPendingFrames[Index].Release());
+            Finished->Timestamps.Empty();
+            UE::Tasks::Launch(UE_SOURCE_LOCATION, [Finished]()
+            {
+                WriteFrame(*Finished);
+            });
+
+            GPendingFrames.RemoveAt(Index);
+        }
+    }
+}
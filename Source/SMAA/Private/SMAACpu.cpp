@@ -0,0 +1,216 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SMAACpu.h"
+#include "ImageCore.h"
+#include "Math/Float16.h"
+
+namespace SMAACpu
+{
+    // Rounds values the SMAA_USE_FP16 shaders hold as SMAAReal
+    static float ToReal(float Value, bool bHalfPrecision)
+    {
+        return bHalfPrecision ? FFloat16(Value).GetFloat() : Value;
+    }
+
+    // Same weights as GetLuma in SMAAEdgeDetection.usf
+    static float GetLuma(const FLinearColor& Color)
+    {
+        return Color.R * 0.299f + Color.G * 0.587f + Color.B * 0.114f;
+    }
+
+    // Exact sRGB encode, the inverse of the decode ImageCore applies to sRGB sources
+    static float LinearToSRGB(float Value)
+    {
+        return Value <= 0.0031308f ? Value * 12.92f : 1.055f * FMath::Pow(Value, 1.0f / 2.4f) - 0.055f;
+    }
+
+    // HDR: same compression as GetPerceptualColor in SMAAEdgeDetection.usf
+    // LDR: ImageCore decodes sRGB sources to linear, re-encode so thresholds match the post-tonemap GPU path
+    static FLinearColor GetPerceptualColor(const FLinearColor& Color, bool bHDRInput)
+    {
+        FLinearColor Out;
+        for (int32 Channel = 0; Channel < 3; ++Channel)
+        {
+            const float Value = FMath::Max(Color.Component(Channel), 0.0f);
+            Out.Component(Channel) = bHDRInput ? FMath::Sqrt(Value / (1.0f + Value)) : LinearToSRGB(FMath::Min(Value, 1.0f));
+        }
+        Out.A = Color.A;
+        return Out;
+    }
+
+    // Coverage of a pixel by a Z-shaped line through a run of edge pixels.
+    // X = weight on this pixel's side of the edge, Y = weight on the neighbor's side.
+    // Analytic approximation of the AreaTex lookup (no crossing edge shapes), see SMAACpu.h
+    static FVector2f GetLineArea(int32 DistNegative, int32 DistPositive)
+    {
+        const float Length = float(DistNegative + DistPositive + 1);
+        const float Area = 0.5f - (float(DistNegative) + 0.5f) / Length;
+        return Area >= 0.0f ? FVector2f(Area, 0.0f) : FVector2f(0.0f, -Area);
+    }
+
+    void DetectEdges(const FImage& Image, bool bHDRInput, const FSMAASettings& Settings, TArray<uint8>& OutEdges, bool bHalfPrecision)
+    {
+        const int32 Width = Image.SizeX;
+        const int32 Height = Image.SizeY;
+        TArrayView64<const FLinearColor> Pixels = Image.AsRGBA32F();
+
+        // Convert once per pixel, each value is read by up to three edge tests
+        // (the compression runs in 32 bit on the GPU as well, only its result is rounded)
+        TArray<FLinearColor> Perceptual;
+        Perceptual.SetNumUninitialized(Width * Height);
+        for (int32 Index = 0; Index < Width * Height; ++Index)
+        {
+            const FLinearColor Color = GetPerceptualColor(Pixels[Index], bHDRInput);
+            Perceptual[Index] = FLinearColor(ToReal(Color.R, bHalfPrecision), ToReal(Color.G, bHalfPrecision), ToReal(Color.B, bHalfPrecision), Color.A);
+        }
+
+        auto GetRealLuma = [bHalfPrecision](const FLinearColor& Color)
+        {
+            return ToReal(GetLuma(Color), bHalfPrecision);
+        };
+
+        OutEdges.SetNumZeroed(Width * Height);
+
+        for (int32 Y = 0; Y < Height; ++Y)
+        {
+            for (int32 X = 0; X < Width; ++X)
+            {
+                // Clamp like the GPU sampler, so the border never reports an edge
+                const FLinearColor& C = Perceptual[Y * Width + X];
+                const FLinearColor& L = Perceptual[Y * Width + FMath::Max(X - 1, 0)];
+                const FLinearColor& T = Perceptual[FMath::Max(Y - 1, 0) * Width + X];
+
+                float DeltaLeft;
+                float DeltaTop;
+                // No GBuffer here, geometric detection falls back to luma like on the GPU without one
+                if (Settings.EdgeDetectionMode == ESMAAEdgeDetectionMode::Luma || Settings.EdgeDetectionMode == ESMAAEdgeDetectionMode::Geometric)
+                {
+                    DeltaLeft = FMath::Abs(GetRealLuma(C) - GetRealLuma(L));
+                    DeltaTop = FMath::Abs(GetRealLuma(C) - GetRealLuma(T));
+                }
+                else
+                {
+                    DeltaLeft = FMath::Max3(FMath::Abs(C.R - L.R), FMath::Abs(C.G - L.G), FMath::Abs(C.B - L.B));
+                    DeltaTop = FMath::Max3(FMath::Abs(C.R - T.R), FMath::Abs(C.G - T.G), FMath::Abs(C.B - T.B));
+                }
+                DeltaLeft = ToReal(DeltaLeft, bHalfPrecision);
+                DeltaTop = ToReal(DeltaTop, bHalfPrecision);
+
+                uint8 Edges = 0;
+                Edges |= DeltaLeft >= Settings.EdgeDetectionThreshold ? EdgeLeft : 0;
+                Edges |= DeltaTop >= Settings.EdgeDetectionThreshold ? EdgeTop : 0;
+                OutEdges[Y * Width + X] = Edges;
+            }
+        }
+    }
+
+    void CalculateBlendingWeights(const TArray<uint8>& Edges, int32 Width, int32 Height, const FSMAASettings& Settings, TArray<FVector4f>& OutWeights, bool bHalfPrecision)
+    {
+        // Same reach as the GPU passes, which step two pixels per search step
+        const int32 MaxDistance = Settings.MaxSearchSteps * 2;
+
+        auto HasEdge = [&Edges, Width, Height](int32 X, int32 Y, uint8 Bit)
+        {
+            return X >= 0 && X < Width && Y >= 0 && Y < Height && (Edges[Y * Width + X] & Bit) != 0;
+        };
+
+        auto Search = [&HasEdge, MaxDistance](int32 X, int32 Y, int32 StepX, int32 StepY, uint8 Bit)
+        {
+            int32 Dist = 0;
+            while (Dist < MaxDistance && HasEdge(X + StepX * (Dist + 1), Y + StepY * (Dist + 1), Bit))
+            {
+                ++Dist;
+            }
+            return Dist;
+        };
+
+        OutWeights.SetNumZeroed(Width * Height);
+
+        for (int32 Y = 0; Y < Height; ++Y)
+        {
+            for (int32 X = 0; X < Width; ++X)
+            {
+                const uint8 PixelEdges = Edges[Y * Width + X];
+                FVector4f& Weights = OutWeights[Y * Width + X];
+
+                if (PixelEdges & EdgeTop)
+                {
+                    const FVector2f Area = GetLineArea(Search(X, Y, -1, 0, EdgeTop), Search(X, Y, 1, 0, EdgeTop));
+                    Weights.X = ToReal(Area.X, bHalfPrecision);
+                    Weights.Y = ToReal(Area.Y, bHalfPrecision);
+                }
+
+                if (PixelEdges & EdgeLeft)
+                {
+                    const FVector2f Area = GetLineArea(Search(X, Y, 0, -1, EdgeLeft), Search(X, Y, 0, 1, EdgeLeft));
+                    Weights.Z = ToReal(Area.X, bHalfPrecision);
+                    Weights.W = ToReal(Area.Y, bHalfPrecision);
+                }
+            }
+        }
+    }
+
+    void BlendNeighborhood(FImage& Image, const TArray<FVector4f>& Weights, bool bHalfPrecision)
+    {
+        const int32 Width = Image.SizeX;
+        const int32 Height = Image.SizeY;
+        TArrayView64<FLinearColor> Pixels = Image.AsRGBA32F();
+
+        // Blending reads unmodified neighbors
+        const TArray<FLinearColor> Source(Pixels.GetData(), Pixels.Num());
+
+        for (int32 Y = 0; Y < Height; ++Y)
+        {
+            for (int32 X = 0; X < Width; ++X)
+            {
+                // Same neighbor weights as SMAANeighborhoodBlending.usf
+                const float WeightTop = Weights[Y * Width + X].X;
+                const float WeightLeft = Weights[Y * Width + X].Z;
+                const float WeightRight = X + 1 < Width ? Weights[Y * Width + X + 1].Z : 0.0f;
+                const float WeightBottom = Y + 1 < Height ? Weights[(Y + 1) * Width + X].X : 0.0f;
+
+                if (WeightTop + WeightLeft + WeightRight + WeightBottom < 0.001f)
+                {
+                    continue;
+                }
+
+                int32 NeighborX = X;
+                int32 NeighborY = Y;
+                float Weight;
+                if (FMath::Max(WeightLeft, WeightRight) > FMath::Max(WeightTop, WeightBottom))
+                {
+                    const bool bLeft = WeightLeft > WeightRight;
+                    NeighborX = bLeft ? FMath::Max(X - 1, 0) : FMath::Min(X + 1, Width - 1);
+                    Weight = bLeft ? WeightLeft : WeightRight;
+                }
+                else
+                {
+                    const bool bTop = WeightTop > WeightBottom;
+                    NeighborY = bTop ? FMath::Max(Y - 1, 0) : FMath::Min(Y + 1, Height - 1);
+                    Weight = bTop ? WeightTop : WeightBottom;
+                }
+
+                // The GPU shifts its bilinear tap by half the weight towards the neighbor
+                const FLinearColor& Color = Source[Y * Width + X];
+                const FLinearColor& Neighbor = Source[NeighborY * Width + NeighborX];
+                const float Alpha = Color.A;
+                const FLinearColor Blended = FMath::Lerp(Color, Neighbor, Weight * 0.5f);
+                Pixels[Y * Width + X] = FLinearColor(ToReal(Blended.R, bHalfPrecision), ToReal(Blended.G, bHalfPrecision), ToReal(Blended.B, bHalfPrecision), Alpha);
+            }
+        }
+    }
+
+    void Process(FImage& Image, bool bHDRInput, const FSMAASettings& Settings, bool bHalfPrecision)
+    {
+        check(Image.Format == ERawImageFormat::RGBA32F);
+
+        TArray<uint8> Edges;
+        DetectEdges(Image, bHDRInput, Settings, Edges, bHalfPrecision);
+
+        TArray<FVector4f> Weights;
+        CalculateBlendingWeights(Edges, Image.SizeX, Image.SizeY, Settings, Weights, bHalfPrecision);
+
+        BlendNeighborhood(Image, Weights, bHalfPrecision);
+    }
+}
@@ -0,0 +1,281 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SMAAPipelineCache.h"
+#include "SMAAShaders.h"
+#include "SMAASettings.h"
+#include "CommonRenderResources.h"
+#include "GlobalShader.h"
+#include "HAL/IConsoleManager.h"
+#include "PipelineStateCache.h"
+#include "RenderingThread.h"
+#include "RHIStaticStates.h"
+#include "ScreenPass.h"
+
+namespace SMAAPipelineCache
+{
+    // Pixel shader + render target format of every screen pass already checked against the PSO cache at draw time
+    static TSet<TPair<FRHIPixelShader*, EPixelFormat>> GCheckedPipelines;
+    static TSet<TPair<FRHIPixelShader*, EPixelFormat>> GLatePipelines;
+    static FCriticalSection GPipelinesLock;
+
+    // Settings the neighborhood pipelines were last precached for, see the cvar sink below
+    static uint32 GPrecachedNeighborhoodHash = 0;
+    static bool GPipelinesPrecached = false;
+
+    // Scene color formats the neighborhood pass writes, depending on insertion point and HDR output
+    static const EPixelFormat GSceneColorFormats[] = { PF_B8G8R8A8, PF_R8G8B8A8, PF_A2B10G10R10, PF_FloatRGBA, PF_FloatR11G11B10 };
+
+    // Mirrors the pipeline AddDrawScreenPass builds
+    static FGraphicsPipelineStateInitializer GetScreenPassInitializer(FRHIVertexShader* VertexShader, FRHIPixelShader* PixelShader, EPixelFormat RenderTargetFormat)
+    {
+        FGraphicsPipelineStateInitializer Initializer;
+        Initializer.BoundShaderState.VertexDeclarationRHI = GFilterVertexDeclaration.VertexDeclarationRHI;
+        Initializer.BoundShaderState.VertexShaderRHI = VertexShader;
+        Initializer.BoundShaderState.PixelShaderRHI = PixelShader;
+        Initializer.BlendState = TStaticBlendState<>::GetRHI();
+        Initializer.RasterizerState = TStaticRasterizerState<>::GetRHI();
+        Initializer.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
+        Initializer.PrimitiveType = PT_TriangleList;
+        Initializer.RenderTargetsEnabled = 1;
+        Initializer.RenderTargetFormats[0] = RenderTargetFormat;
+        Initializer.RenderTargetFlags[0] = TexCreate_ShaderResource | TexCreate_RenderTargetable;
+        Initializer.NumSamples = 1;
+        Initializer.StatePrecachePSOHash = RHIComputeStatePrecachePSOHash(Initializer);
+        return Initializer;
+    }
+
+    static void PrecacheScreenPass(FRHIVertexShader* VertexShader, FRHIPixelShader* PixelShader, EPixelFormat RenderTargetFormat)
+    {
+        PipelineStateCache::PrecacheGraphicsPipelineState(GetScreenPassInitializer(VertexShader, PixelShader, RenderTargetFormat));
+    }
+
+    // Only the fused permutation the cvars select is precached (all 24 combinations are too many to precache blindly)
+    static uint32 GetNeighborhoodSettingsHash(const FSMAASettings& Settings)
+    {
+        uint32 Hash = GetTypeHash(Settings.IsHDRInput());
+        Hash = HashCombine(Hash, GetTypeHash(Settings.SharpenAmount > 0.0f));
+        Hash = HashCombine(Hash, GetTypeHash(Settings.GrainIntensity > 0.0f));
+        Hash = HashCombine(Hash, GetTypeHash(Settings.bDither));
+        Hash = HashCombine(Hash, GetTypeHash(static_cast<uint32>(Settings.ColorConversion)));
+        Hash = HashCombine(Hash, GetTypeHash(Settings.bUpscale));
+        return Hash;
+    }
+
+    // Neighborhood blending writes the scene color format, plain and with the configured fused stages
+    static int32 PrecacheNeighborhoodPipelines(FGlobalShaderMap* ShaderMap, FRHIVertexShader* VertexShaderRHI, const FSMAASettings& Settings)
+    {
+        int32 NumPipelines = 0;
+
+        // HDR input never runs the fused stages, see AddNeighborhoodBlendingPass
+        const bool bFusedStages = !Settings.IsHDRInput();
+
+        FSMAANeighborhoodBlendingPS::FPermutationDomain FusedPermutation;
+        FusedPermutation.Set<FSMAAFusedSharpenDim>(bFusedStages && Settings.SharpenAmount > 0.0f);
+        FusedPermutation.Set<FSMAAFusedGrainDim>(bFusedStages && Settings.GrainIntensity > 0.0f);
+        FusedPermutation.Set<FSMAAFusedDitherDim>(bFusedStages && Settings.bDither);
+        FusedPermutation.Set<FSMAAFusedColorConversionDim>(bFusedStages ? static_cast<int32>(Settings.ColorConversion) : 0);
+
+        TArray<FSMAANeighborhoodBlendingPS::FPermutationDomain, TInlineAllocator<2>> Permutations;
+        Permutations.Add(FSMAANeighborhoodBlendingPS::FPermutationDomain());
+        Permutations.AddUnique(FusedPermutation);
+
+        for (const FSMAANeighborhoodBlendingPS::FPermutationDomain& PermutationVector : Permutations)
+        {
+            TShaderMapRef<FSMAANeighborhoodBlendingPS> PixelShader(ShaderMap, PermutationVector);
+            for (EPixelFormat Format : GSceneColorFormats)
+            {
+                PrecacheScreenPass(VertexShaderRHI, PixelShader.GetPixelShader(), Format);
+                ++NumPipelines;
+            }
+        }
+
+        // The upscaling variant writes the same formats at output resolution
+        if (Settings.bUpscale)
+        {
+            FSMAANeighborhoodUpscalePS::FPermutationDomain UpscalePermutation;
+            UpscalePermutation.Set<FSMAAFusedSharpenDim>(Settings.SharpenAmount > 0.0f);
+            UpscalePermutation.Set<FSMAAFusedGrainDim>(Settings.GrainIntensity > 0.0f);
+            UpscalePermutation.Set<FSMAAFusedDitherDim>(Settings.bDither);
+            UpscalePermutation.Set<FSMAAFusedColorConversionDim>(static_cast<int32>(Settings.ColorConversion));
+
+            TShaderMapRef<FSMAANeighborhoodUpscalePS> PixelShader(ShaderMap, UpscalePermutation);
+            for (EPixelFormat Format : GSceneColorFormats)
+            {
+                PrecacheScreenPass(VertexShaderRHI, PixelShader.GetPixelShader(), Format);
+                ++NumPipelines;
+            }
+        }
+
+        GPrecachedNeighborhoodHash = GetNeighborhoodSettingsHash(Settings);
+        return NumPipelines;
+    }
+
+    // Changing the fused stages or the upscaler at runtime selects permutations that were not precached at startup
+    static void OnSettingsChanged()
+    {
+        if (!GPipelinesPrecached)
+        {
+            return;
+        }
+
+        ENQUEUE_RENDER_COMMAND(SMAAPrecacheNeighborhoodPipelines)([](FRHICommandListImmediate& RHICmdList)
+        {
+            const FSMAASettings Settings = FSMAASettings::GetRuntimeSettings();
+            FGlobalShaderMap* ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+            if (!ShaderMap || GMaxRHIFeatureLevel < ERHIFeatureLevel::SM5 || GetNeighborhoodSettingsHash(Settings) == GPrecachedNeighborhoodHash)
+            {
+                return;
+            }
+
+            TShaderMapRef<FScreenPassVS> VertexShader(ShaderMap);
+            const int32 NumPipelines = PrecacheNeighborhoodPipelines(ShaderMap, VertexShader.GetVertexShader(), Settings);
+            UE_LOG(LogTemp, Log, TEXT("SMAA: Settings changed, requested precaching of %d neighborhood pipelines"), NumPipelines);
+        });
+    }
+
+    static FAutoConsoleVariableSink CVarSinkSMAAPipelines(FConsoleCommandDelegate::CreateStatic(&OnSettingsChanged));
+
+    void PrecachePipelines()
+    {
+        check(IsInRenderingThread());
+
+        FGlobalShaderMap* ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+        if (!ShaderMap)
+        {
+            return;
+        }
+
+        TShaderMapRef<FScreenPassVS> VertexShader(ShaderMap);
+        FRHIVertexShader* VertexShaderRHI = VertexShader.GetVertexShader();
+        int32 NumPipelines = 0;
+
+        // Mobile only has the three pixel shader passes, see SMAARendering::IsMobilePath
+        if (GMaxRHIFeatureLevel < ERHIFeatureLevel::SM5)
+        {
+            FSMAAEdgeDetectionPS::FPermutationDomain EdgePermutation;
+            EdgePermutation.Set<FSMAAMobileDim>(true);
+            PrecacheScreenPass(VertexShaderRHI, TShaderMapRef<FSMAAEdgeDetectionPS>(ShaderMap, EdgePermutation).GetPixelShader(), PF_R8);
+
+            FSMAABlendingWeightPS::FPermutationDomain BlendPermutation;
+            BlendPermutation.Set<FSMAAMobileDim>(true);
+            PrecacheScreenPass(VertexShaderRHI, TShaderMapRef<FSMAABlendingWeightPS>(ShaderMap, BlendPermutation).GetPixelShader(), PF_FloatRGBA);
+
+            FSMAANeighborhoodBlendingPS::FPermutationDomain NeighborhoodPermutation;
+            NeighborhoodPermutation.Set<FSMAAMobileDim>(true);
+            for (EPixelFormat Format : GSceneColorFormats)
+            {
+                PrecacheScreenPass(VertexShaderRHI, TShaderMapRef<FSMAANeighborhoodBlendingPS>(ShaderMap, NeighborhoodPermutation).GetPixelShader(), Format);
+            }
+
+            UE_LOG(LogTemp, Log, TEXT("SMAA: Requested precaching of %d mobile pipelines"), 2 + static_cast<int32>(UE_ARRAY_COUNT(GSceneColorFormats)));
+            return;
+        }
+
+        // Edge detection and upsample always write the RGBA8 edge texture
+        for (bool bTileReuse : { false, true })
+        {
+            for (bool bMask : { false, true })
+            {
+                for (bool bGeometric : { false, true })
+                {
+                    FSMAAEdgeDetectionPS::FPermutationDomain PermutationVector;
+                    PermutationVector.Set<FSMAATileReuseDim>(bTileReuse);
+                    PermutationVector.Set<FSMAAMaskDim>(bMask);
+                    PermutationVector.Set<FSMAAGeometricDim>(bGeometric);
+                    TShaderMapRef<FSMAAEdgeDetectionPS> PixelShader(ShaderMap, PermutationVector);
+                    PrecacheScreenPass(VertexShaderRHI, PixelShader.GetPixelShader(), PF_R8G8B8A8);
+                    ++NumPipelines;
+                }
+            }
+        }
+        {
+            TShaderMapRef<FSMAAEdgeUpsamplePS> PixelShader(ShaderMap);
+            PrecacheScreenPass(VertexShaderRHI, PixelShader.GetPixelShader(), PF_R8G8B8A8);
+            ++NumPipelines;
+        }
+
+        // Blending weights write RGBA16F, with and without packed edges and tile reuse
+        for (bool bPackedEdges : { false, true })
+        {
+            for (bool bTileReuse : { false, true })
+            {
+                FSMAABlendingWeightPS::FPermutationDomain PermutationVector;
+                PermutationVector.Set<FSMAAPackedEdgesDim>(bPackedEdges);
+                PermutationVector.Set<FSMAATileReuseDim>(bTileReuse);
+                TShaderMapRef<FSMAABlendingWeightPS> PixelShader(ShaderMap, PermutationVector);
+                PrecacheScreenPass(VertexShaderRHI, PixelShader.GetPixelShader(), PF_FloatRGBA);
+                ++NumPipelines;
+            }
+        }
+
+        NumPipelines += PrecacheNeighborhoodPipelines(ShaderMap, VertexShaderRHI, FSMAASettings::GetRuntimeSettings());
+
+        // Compute pipelines
+        PipelineStateCache::PrecacheComputePipelineState(TShaderMapRef<FSMAAEdgeDetectionCS>(ShaderMap).GetComputeShader());
+        PipelineStateCache::PrecacheComputePipelineState(TShaderMapRef<FSMAAEdgePackCS>(ShaderMap).GetComputeShader());
+        PipelineStateCache::PrecacheComputePipelineState(TShaderMapRef<FSMAATileClassifyCS>(ShaderMap).GetComputeShader());
+        NumPipelines += 3;
+        for (bool bMask : { false, true })
+        {
+            for (bool bGeometric : { false, true })
+            {
+                FSMAATileHashCS::FPermutationDomain PermutationVector;
+                PermutationVector.Set<FSMAAMaskDim>(bMask);
+                PermutationVector.Set<FSMAAGeometricDim>(bGeometric);
+                PipelineStateCache::PrecacheComputePipelineState(TShaderMapRef<FSMAATileHashCS>(ShaderMap, PermutationVector).GetComputeShader());
+                ++NumPipelines;
+            }
+        }
+        for (bool bPackedEdges : { false, true })
+        {
+            FSMAABlendingWeightCS::FPermutationDomain PermutationVector;
+            PermutationVector.Set<FSMAAPackedEdgesDim>(bPackedEdges);
+            PipelineStateCache::PrecacheComputePipelineState(TShaderMapRef<FSMAABlendingWeightCS>(ShaderMap, PermutationVector).GetComputeShader());
+            ++NumPipelines;
+        }
+
+        GPipelinesPrecached = true;
+        UE_LOG(LogTemp, Log, TEXT("SMAA: Requested precaching of %d pipelines"), NumPipelines);
+    }
+
+    void NotifyDraw(const TCHAR* PassName, FRHIPixelShader* PixelShader, EPixelFormat RenderTargetFormat)
+    {
+        const TPair<FRHIPixelShader*, EPixelFormat> Key(PixelShader, RenderTargetFormat);
+
+        FScopeLock Lock(&GPipelinesLock);
+        if (GCheckedPipelines.Contains(Key))
+        {
+            return;
+        }
+        GCheckedPipelines.Add(Key);
+
+        FGlobalShaderMap* ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+        if (!ShaderMap)
+        {
+            return;
+        }
+
+        // Ask the engine's PSO cache, a pipeline requested at startup may still be compiling or may have been evicted
+        TShaderMapRef<FScreenPassVS> VertexShader(ShaderMap);
+        const EPSOPrecacheResult Result = PipelineStateCache::CheckPipelineStateInCache(GetScreenPassInitializer(VertexShader.GetVertexShader(), PixelShader, RenderTargetFormat));
+
+        // Complete pipelines are ready, Unknown/Untracked/NotSupported mean precaching is off and nothing can be reported
+        if (Result != EPSOPrecacheResult::Active && Result != EPSOPrecacheResult::Missed && Result != EPSOPrecacheResult::TooLate)
+        {
+            return;
+        }
+
+        GLatePipelines.Add(Key);
+        UE_LOG(LogTemp, Warning, TEXT("SMAA: Pipeline for %s (%s) is %s at draw time and compiles on the render thread (%d late so far)"),
+            PassName, GetPixelFormatString(RenderTargetFormat),
+            Result == EPSOPrecacheResult::Active ? TEXT("still compiling") : TEXT("missing from the PSO cache"),
+            GLatePipelines.Num());
+    }
+
+    int32 GetNumLatePipelines()
+    {
+        FScopeLock Lock(&GPipelinesLock);
+        return GLatePipelines.Num();
+    }
+}
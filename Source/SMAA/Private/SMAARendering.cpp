@@ -11,15 +11,94 @@
 #include "RenderGraphUtils.h"
 #include "SceneView.h"
 #include "SMAATextures.h"
+#include "SMAAPipelineCache.h"
+#include "SMAASceneCaptureComponent.h"
+#include "SMAACapture.h"
 
 namespace SMAARendering
 {
+	//Bit-packed edges, only created when FSMAASettings::bUsePackedEdges is set
+	struct FSMAAPackedEdges
+	{
+		FRDGTextureRef Horizontal = nullptr;
+		FRDGTextureRef Vertical = nullptr;
+
+		bool IsValid() const { return Horizontal != nullptr && Vertical != nullptr; }
+	};
+
+	//Static tile reuse inputs, only created when a view has a matching history
+	struct FSMAATileReuse
+	{
+		FRDGTextureRef TileState = nullptr;
+		FRDGTextureRef HistoryBlendWeights = nullptr;
+
+		bool IsValid() const { return TileState != nullptr && HistoryBlendWeights != nullptr; }
+	};
+
+	//Mobile (ES3.1) views take the low-cost path: mediump math, single-channel edges, reduced search steps
+	static bool IsMobilePath(const FViewInfo& View)
+	{
+		return View.GetFeatureLevel() < ERHIFeatureLevel::SM5;
+	}
+
+	//Every mobile pass writes all of its pixels, so targets are neither cleared nor loaded (no extra tile memory traffic)
+	static ERenderTargetLoadAction GetLoadAction(const FViewInfo& View)
+	{
+		return IsMobilePath(View) ? ERenderTargetLoadAction::ENoAction : ERenderTargetLoadAction::EClear;
+	}
+
 	//Forward decleration for indivisual passes
-	static FRDGTextureRef AddEdgeDetectionPass(FRDGBuilder& GraphBuilder, const FViewInfo& View, FRDGTextureRef SceneColor, FRDGTextureRef SceneDepth, const FSMAASettings& Settings);
-	static FRDGTextureRef AddBlendingWeightPass(FRDGBuilder& GraphBuilder, const FViewInfo& View, FRDGTextureRef EdgeTexture, const FSMAASettings& Settings);
+	static FRDGTextureRef AddEdgeAndBlendingWeightPasses(FRDGBuilder& GraphBuilder, const FViewInfo& View, const FScreenPassTexture& SceneColor, const FScreenPassTexture& SceneDepth, const FSMAASettings& PassSettings, FSMAAViewHistory* History, const FSMAAMaskTextures& MaskTextures, const FSMAAGBufferTextures& GBufferTextures, SMAACapture::FFrame* CaptureFrame, FRDGTextureRef& OutEdgeTexture);
+	static FSMAATileReuse AddTileReusePasses(FRDGBuilder& GraphBuilder, const FViewInfo& View, FRDGTextureRef SceneColor, const FIntRect& SceneColorRect, const FSMAAMaskTextures* Mask, const FSMAAGBufferTextures* GBuffer, const FSMAASettings& Settings, FSMAAViewHistory& History);
+	static FRDGTextureRef AddEdgeDetectionPass(FRDGBuilder& GraphBuilder, const FViewInfo& View, FRDGTextureRef SceneColor, FRDGTextureRef SceneDepth, const FIntRect& SceneColorRect, const FSMAATileReuse& TileReuse, const FSMAAMaskTextures* Mask, const FSMAAGBufferTextures& GBuffer, const FSMAASettings& Settings);
+	static FRDGTextureRef AddEdgeDetectionComputePass(FRDGBuilder& GraphBuilder, const FViewInfo& View, FRDGTextureRef SceneColor, const FSMAASettings& Settings);
+	static FRDGTextureRef AddEdgeUpsamplePass(FRDGBuilder& GraphBuilder, const FViewInfo& View, FRDGTextureRef SparseEdgeTexture, FIntPoint Extent);
+	static FSMAAPackedEdges AddEdgePackPass(FRDGBuilder& GraphBuilder, const FViewInfo& View, FRDGTextureRef EdgeTexture);
+	static FRDGTextureRef AddBlendingWeightPass(FRDGBuilder& GraphBuilder, const FViewInfo& View, FRDGTextureRef EdgeTexture, const FSMAAPackedEdges& PackedEdges, const FSMAATileReuse& TileReuse, const FSMAASettings& Settings);
 	static FRDGTextureRef AddNeighborhoodBlendingPass(FRDGBuilder& GraphBuilder, const FViewInfo& View, FRDGTextureRef SceneColor, FRDGTextureRef BlendTexture, const FSMAASettings& Settings);
 
-	bool ShouldRenderSMAA(const FViewInfo& View)
+	//Maps edge pass UVs onto a render resolution texture (mask, GBuffer) that holds the view at TargetRect
+	//(the scene color may already be upscaled)
+	static void GetUVToPixelTransform(FIntPoint SceneColorExtent, const FIntRect& SceneColorRect, const FIntRect& TargetRect, FVector2f& OutScale, FVector2f& OutBias)
+	{
+		const FVector2f RectScale(
+			float(TargetRect.Width()) / SceneColorRect.Width(),
+			float(TargetRect.Height()) / SceneColorRect.Height());
+
+		OutScale = FVector2f(SceneColorExtent) * RectScale;
+		OutBias = FVector2f(TargetRect.Min) - FVector2f(SceneColorRect.Min) * RectScale;
+	}
+
+	//Mask parameters of the edge detection pass and the tile hash (SMAAMask.ush)
+	template<typename TParameters>
+	static void SetMaskParameters(FRDGBuilder& GraphBuilder, TParameters* PassParameters, const FSMAAMaskTextures& Mask, FIntPoint SceneColorExtent, const FIntRect& SceneColorRect, const FSMAASettings& Settings)
+	{
+		PassParameters->CustomDepthTexture = Mask.CustomDepth ? Mask.CustomDepth : GSystemTextures.GetBlackDummy(GraphBuilder);
+		PassParameters->CustomStencilTexture = Mask.CustomStencil ? Mask.CustomStencil : GraphBuilder.CreateSRV(FRDGTextureSRVDesc(GSystemTextures.GetZeroUIntDummy(GraphBuilder)));
+		PassParameters->MaskMode = static_cast<uint32>(Settings.MaskMode);
+		PassParameters->MaskStencilMask = static_cast<uint32>(Settings.MaskStencilMask);
+		PassParameters->bMaskInvert = Settings.bInvertMask ? 1u : 0u;
+		GetUVToPixelTransform(SceneColorExtent, SceneColorRect, Mask.ViewRect, PassParameters->MaskUVToPixelScale, PassParameters->MaskUVToPixelBias);
+	}
+
+	//Every setting that changes edges or weights invalidates the history
+	static uint32 GetTileReuseSettingsHash(const FSMAASettings& Settings)
+	{
+		uint32 Hash = GetTypeHash(static_cast<uint32>(Settings.EdgeDetectionMode));
+		Hash = HashCombine(Hash, GetTypeHash(Settings.EdgeDetectionThreshold));
+		Hash = HashCombine(Hash, GetTypeHash(Settings.GeometricNormalThreshold));
+		Hash = HashCombine(Hash, GetTypeHash(Settings.GeometricDepthThreshold));
+		Hash = HashCombine(Hash, GetTypeHash(Settings.MaxSearchSteps));
+		Hash = HashCombine(Hash, GetTypeHash(Settings.bUseCornerDetection));
+		Hash = HashCombine(Hash, GetTypeHash(Settings.bUseDiagonalDetection));
+		Hash = HashCombine(Hash, GetTypeHash(Settings.IsHDRInput()));
+		Hash = HashCombine(Hash, GetTypeHash(static_cast<uint32>(Settings.MaskMode)));
+		Hash = HashCombine(Hash, GetTypeHash(Settings.MaskStencilMask));
+		Hash = HashCombine(Hash, GetTypeHash(Settings.bInvertMask));
+		return Hash;
+	}
+
+	bool ShouldRenderSMAA(const FSceneView& View)
 	{
         // Don't run in wireframe or debug views
         if (View.Family->EngineShowFlags.Wireframe)
@@ -28,7 +107,14 @@ namespace SMAARendering
         }
 
         // Don't run in editor viewports unless game view is enabled
-        if (View.bIsSceneCapture || View.bIsReflectionCapture)
+        if (View.bIsReflectionCapture)
+        {
+            return false;
+        }
+
+        // Scene captures opt in through USMAASceneCaptureComponent
+        ESMAAQualityPreset CaptureQualityPreset;
+        if (View.bIsSceneCapture && !(View.State && SMAASceneCaptures::Find(View.State->GetViewKey(), CaptureQualityPreset)))
         {
             return false;
         }
@@ -36,30 +122,242 @@ namespace SMAARendering
         return true;
 	}
 
-    FScreenPassTexture AddSMAAPasses(FRDGBuilder& GraphBuilder, const FViewInfo& View, const FScreenPassTexture& SceneColor, const FScreenPassTexture& SceneDepth, const FSMAASettings& Settings) {
+    //The mobile path only has the three pixel shader passes at full resolution
+    static FSMAASettings GetPassSettings(const FViewInfo& View, const FSMAASettings& Settings)
+    {
+        FSMAASettings PassSettings = Settings;
+        if (IsMobilePath(View))
+        {
+            PassSettings.EdgeDetectionResolution = ESMAAEdgeDetectionResolution::Full;
+            PassSettings.bUseComputeEdgeDetection = false;
+            PassSettings.bUseComputeBlendingWeight = false;
+            PassSettings.bUsePackedEdges = false;
+            PassSettings.MaxSearchSteps = FMath::Min(PassSettings.MaxSearchSteps, FSMAABlendingWeightPS::MobileMaxSearchSteps);
+            PassSettings.DebugMode = ESMAADebugMode::None;
+            PassSettings.MaskMode = ESMAAMaskMode::None;
+        }
+        return PassSettings;
+    }
+
+    FScreenPassTexture AddSMAAPasses(FRDGBuilder& GraphBuilder, const FViewInfo& View, const FScreenPassTexture& SceneColor, const FScreenPassTexture& SceneDepth, const FSMAASettings& Settings, FSMAAViewHistory* History, const FSMAAMaskTextures& MaskTextures, const FSMAAGBufferTextures& GBufferTextures) {
         check(SceneColor.IsValid());
 
         RDG_EVENT_SCOPE(GraphBuilder, "SMAA");
 
+        const FSMAASettings PassSettings = GetPassSettings(View, Settings);
+
+        // Null unless r.SMAA.Capture requested this frame
+        SMAACapture::FFrame* CaptureFrame = SMAACapture::BeginFrame(GraphBuilder, View);
+
+        //Pass 1 and 2: Edge Detection and Blending Weight Calculation
+        FRDGTextureRef EdgeTexture = nullptr;
+        FRDGTextureRef BlendWeightTexture = AddEdgeAndBlendingWeightPasses(GraphBuilder, View, SceneColor, SceneDepth, PassSettings, History, MaskTextures, GBufferTextures, CaptureFrame, EdgeTexture);
+
+        // Pass 3: Neighborhood Blending
+        FRDGTextureRef OutputTexture = AddNeighborhoodBlendingPass(GraphBuilder, View, SceneColor.Texture, BlendWeightTexture,PassSettings);
+        SMAACapture::MarkPass(GraphBuilder, CaptureFrame, TEXT("NeighborhoodBlending"));
+
+        SMAACapture::CaptureTextures(GraphBuilder, CaptureFrame, EdgeTexture, BlendWeightTexture);
+        SMAACapture::EndFrame(CaptureFrame);
+
+        return FScreenPassTexture(OutputTexture, SceneColor.ViewRect);
+    }
+
+    FRDGTextureRef AddSMAABlendingWeightPasses(FRDGBuilder& GraphBuilder, const FViewInfo& View, const FScreenPassTexture& SceneColor, const FScreenPassTexture& SceneDepth, const FSMAASettings& Settings, FSMAAViewHistory* History, const FSMAAMaskTextures& MaskTextures, const FSMAAGBufferTextures& GBufferTextures)
+    {
+        check(SceneColor.IsValid());
+
+        RDG_EVENT_SCOPE(GraphBuilder, "SMAA");
+
+        SMAACapture::FFrame* CaptureFrame = SMAACapture::BeginFrame(GraphBuilder, View);
+
+        FRDGTextureRef EdgeTexture = nullptr;
+        FRDGTextureRef BlendWeightTexture = AddEdgeAndBlendingWeightPasses(GraphBuilder, View, SceneColor, SceneDepth, GetPassSettings(View, Settings), History, MaskTextures, GBufferTextures, CaptureFrame, EdgeTexture);
+
+        SMAACapture::CaptureTextures(GraphBuilder, CaptureFrame, EdgeTexture, BlendWeightTexture);
+        SMAACapture::EndFrame(CaptureFrame);
+
+        return BlendWeightTexture;
+    }
+
+    FRDGTextureRef AddEdgeAndBlendingWeightPasses(FRDGBuilder& GraphBuilder, const FViewInfo& View, const FScreenPassTexture& SceneColor, const FScreenPassTexture& SceneDepth, const FSMAASettings& PassSettings, FSMAAViewHistory* History, const FSMAAMaskTextures& MaskTextures, const FSMAAGBufferTextures& GBufferTextures, SMAACapture::FFrame* CaptureFrame, FRDGTextureRef& OutEdgeTexture)
+    {
+        // The mask is dropped when the renderer did not provide the texture it reads
+        const bool bMask = (PassSettings.MaskMode == ESMAAMaskMode::CustomStencil && MaskTextures.CustomStencil)
+            || (PassSettings.MaskMode == ESMAAMaskMode::CustomDepth && MaskTextures.CustomDepth);
+
+        // Tile reuse skips work inside the pixel shader passes, so it needs both of them at full resolution
+        const bool bTileReuse = History != nullptr
+            && PassSettings.bReuseStaticTiles
+            && !IsMobilePath(View)
+            && !PassSettings.bUseComputeEdgeDetection
+            && !PassSettings.bUseComputeBlendingWeight
+            && PassSettings.EdgeDetectionResolution == ESMAAEdgeDetectionResolution::Full
+            && PassSettings.DebugMode == ESMAADebugMode::None;
+
+        FSMAATileReuse TileReuse;
+        if (bTileReuse)
+        {
+            const bool bGeometric = PassSettings.EdgeDetectionMode == ESMAAEdgeDetectionMode::Geometric && GBufferTextures.IsValid();
+            TileReuse = AddTileReusePasses(GraphBuilder, View, SceneColor.Texture, SceneColor.ViewRect, bMask ? &MaskTextures : nullptr, bGeometric ? &GBufferTextures : nullptr, PassSettings, *History);
+            SMAACapture::MarkPass(GraphBuilder, CaptureFrame, TEXT("TileReuse"));
+        }
+        else if (History)
+        {
+            *History = FSMAAViewHistory();
+        }
+
         //Pass 1: Edge Detection
         FRDGTextureRef DepthTex = SceneDepth.IsValid() ? SceneDepth.Texture : SceneColor.Texture;
-        FRDGTextureRef EdgeTexture = AddEdgeDetectionPass(GraphBuilder, View, SceneColor.Texture, DepthTex, Settings);
+        FRDGTextureRef EdgeTexture = AddEdgeDetectionPass(GraphBuilder, View, SceneColor.Texture, DepthTex, SceneColor.ViewRect, TileReuse, bMask ? &MaskTextures : nullptr, GBufferTextures, PassSettings);
+        SMAACapture::MarkPass(GraphBuilder, CaptureFrame, TEXT("EdgeDetection"));
+
+        FSMAAPackedEdges PackedEdges;
+        if (PassSettings.bUsePackedEdges)
+        {
+            PackedEdges = AddEdgePackPass(GraphBuilder, View, EdgeTexture);
+            SMAACapture::MarkPass(GraphBuilder, CaptureFrame, TEXT("EdgePack"));
+        }
 
         //Pass 2: Blending Weight Calculation
-        FRDGTextureRef BlendWeightTexture = AddBlendingWeightPass(GraphBuilder,View,EdgeTexture,Settings);
+        FRDGTextureRef BlendWeightTexture = AddBlendingWeightPass(GraphBuilder,View,EdgeTexture,PackedEdges,TileReuse,PassSettings);
+        SMAACapture::MarkPass(GraphBuilder, CaptureFrame, TEXT("BlendingWeight"));
+        OutEdgeTexture = EdgeTexture;
 
-        // Pass 3: Neighborhood Blending
-        FRDGTextureRef OutputTexture = AddNeighborhoodBlendingPass(GraphBuilder, View, SceneColor.Texture, BlendWeightTexture,Settings);
+        if (bTileReuse)
+        {
+            GraphBuilder.QueueTextureExtraction(BlendWeightTexture, &History->BlendWeights);
+        }
 
-        return FScreenPassTexture(OutputTexture, SceneColor.ViewRect);
+        return BlendWeightTexture;
     }
 
-    FRDGTextureRef AddEdgeDetectionPass(FRDGBuilder& GraphBuilder, const FViewInfo& View, FRDGTextureRef SceneColor, FRDGTextureRef SceneDepth, const FSMAASettings& Settings)
+    FSMAATileReuse AddTileReusePasses(FRDGBuilder& GraphBuilder, const FViewInfo& View, FRDGTextureRef SceneColor, const FIntRect& SceneColorRect, const FSMAAMaskTextures* Mask, const FSMAAGBufferTextures* GBuffer, const FSMAASettings& Settings, FSMAAViewHistory& History)
     {
-        //Create edge texture(RG8)
-        const FRDGTextureDesc EdgeDesc = FRDGTextureDesc::Create2D(SceneColor->Desc.Extent, PF_R8G8B8A8, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_RenderTargetable);
+        const FIntPoint Extent = SceneColor->Desc.Extent;
+        const FIntPoint TileCount = FIntPoint::DivideAndRoundUp(Extent, SMAAReuseTileSize);
+        const uint32 SettingsHash = GetTileReuseSettingsHash(Settings);
+
+        const bool bHasHistory = History.BlendWeights.IsValid()
+            && History.TileHashes.IsValid()
+            && History.Extent == Extent
+            && History.SettingsHash == SettingsHash;
+
+        FRDGTextureRef TileHashes = GraphBuilder.CreateTexture(
+            FRDGTextureDesc::Create2D(TileCount, PF_R32_UINT, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV),
+            TEXT("SMAA.TileHashes"));
+        FRDGTextureRef TileChanged = GraphBuilder.CreateTexture(
+            FRDGTextureDesc::Create2D(TileCount, PF_R8_UINT, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV),
+            TEXT("SMAA.TileChanged"));
+
+        // Hashing always runs so the next frame has something to compare against
+        {
+            auto* PassParameters = GraphBuilder.AllocParameters<FSMAATileHashCS::FParameters>();
+            PassParameters->ColorTexture = SceneColor;
+            PassParameters->PreviousTileHashes = bHasHistory ? GraphBuilder.RegisterExternalTexture(History.TileHashes) : GSystemTextures.GetZeroUIntDummy(GraphBuilder);
+            PassParameters->TextureExtent = Extent;
+            PassParameters->bHasHistory = bHasHistory ? 1u : 0u;
+            PassParameters->TileHashes = GraphBuilder.CreateUAV(TileHashes);
+            PassParameters->TileChangedOutput = GraphBuilder.CreateUAV(TileChanged);
+            if (Mask)
+            {
+                // Stencil and custom depth changes that leave the color alone still change the tile
+                SetMaskParameters(GraphBuilder, PassParameters, *Mask, Extent, SceneColorRect, Settings);
+            }
+            if (GBuffer)
+            {
+                // Geometric edges follow depth, normals and shading model, which can change under a constant color
+                PassParameters->GBufferATexture = GBuffer->GBufferA;
+                PassParameters->GBufferBTexture = GBuffer->GBufferB;
+                PassParameters->SceneDepthTexture = GBuffer->SceneDepth;
+                GetUVToPixelTransform(Extent, SceneColorRect, GBuffer->ViewRect, PassParameters->GBufferUVToPixelScale, PassParameters->GBufferUVToPixelBias);
+            }
+
+            FSMAATileHashCS::FPermutationDomain PermutationVector;
+            PermutationVector.Set<FSMAAMaskDim>(Mask != nullptr);
+            PermutationVector.Set<FSMAAGeometricDim>(GBuffer != nullptr);
+            TShaderMapRef<FSMAATileHashCS> ComputeShader(View.ShaderMap, PermutationVector);
+
+            FComputeShaderUtils::AddPass(
+                GraphBuilder,
+                RDG_EVENT_NAME("SMAA TileHash %dx%d", TileCount.X, TileCount.Y),
+                ComputeShader,
+                PassParameters,
+                FIntVector(TileCount.X, TileCount.Y, 1)
+            );
+        }
+
+        GraphBuilder.QueueTextureExtraction(TileHashes, &History.TileHashes);
+        History.Extent = Extent;
+        History.SettingsHash = SettingsHash;
+        History.LastFrameNumber = View.Family->FrameNumber;
+
+        FSMAATileReuse TileReuse;
+        if (!bHasHistory)
+        {
+            return TileReuse;
+        }
+
+        // Weights of a pixel depend on edges up to MaxSearchSteps * 2 pixels (plus one) away along its row/column,
+        // plus one pixel for the crossing edge reads and one for the left/top neighbor each edge compares against
+        // (diagonal searches take MaxSearchSteps single pixel steps, which stays inside that Chebyshev distance).
+        // Geometric depth edges extrapolate from two pixels back and one ahead, one more pixel of reach
+        const int32 EdgeReach = GBuffer ? 4 : 3;
+        const int32 ReuseRadius = FMath::DivideAndRoundUp(2 * Settings.MaxSearchSteps + EdgeReach, SMAAReuseTileSize);
+
+        TileReuse.TileState = GraphBuilder.CreateTexture(
+            FRDGTextureDesc::Create2D(TileCount, PF_R8_UINT, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV),
+            TEXT("SMAA.TileState"));
+        TileReuse.HistoryBlendWeights = GraphBuilder.RegisterExternalTexture(History.BlendWeights);
+
+        auto* PassParameters = GraphBuilder.AllocParameters<FSMAATileClassifyCS::FParameters>();
+        PassParameters->TileChanged = TileChanged;
+        PassParameters->TileCount = TileCount;
+        PassParameters->ReuseRadius = ReuseRadius;
+        PassParameters->TileState = GraphBuilder.CreateUAV(TileReuse.TileState);
+
+        TShaderMapRef<FSMAATileClassifyCS> ComputeShader(View.ShaderMap);
+
+        FComputeShaderUtils::AddPass(
+            GraphBuilder,
+            RDG_EVENT_NAME("SMAA TileClassify"),
+            ComputeShader,
+            PassParameters,
+            FComputeShaderUtils::GetGroupCount(TileCount, FSMAATileClassifyCS::ThreadGroupSize)
+        );
+
+        return TileReuse;
+    }
+
+    FRDGTextureRef AddEdgeDetectionPass(FRDGBuilder& GraphBuilder, const FViewInfo& View, FRDGTextureRef SceneColor, FRDGTextureRef SceneDepth, const FIntRect& SceneColorRect, const FSMAATileReuse& TileReuse, const FSMAAMaskTextures* Mask, const FSMAAGBufferTextures& GBuffer, const FSMAASettings& Settings)
+    {
+        // The compute path shares luma through groupshared memory, so it only covers full resolution luma detection
+        // (and has no early rejection for masked pixels)
+        // Geometric detection reads the GBuffer, views without one (forward shading, mobile) fall back to luma
+        const bool bGeometric = Settings.EdgeDetectionMode == ESMAAEdgeDetectionMode::Geometric && GBuffer.IsValid() && !IsMobilePath(View);
+        const ESMAAEdgeDetectionMode EdgeDetectionMode = (Settings.EdgeDetectionMode == ESMAAEdgeDetectionMode::Geometric && !bGeometric)
+            ? ESMAAEdgeDetectionMode::Luma
+            : Settings.EdgeDetectionMode;
+
+        if (Settings.bUseComputeEdgeDetection
+            && !Mask
+            && EdgeDetectionMode == ESMAAEdgeDetectionMode::Luma
+            && Settings.EdgeDetectionResolution == ESMAAEdgeDetectionResolution::Full)
+        {
+            return AddEdgeDetectionComputePass(GraphBuilder, View, SceneColor, Settings);
+        }
+
+        const bool bHalfResolution = Settings.EdgeDetectionResolution == ESMAAEdgeDetectionResolution::Half;
+        const FIntPoint EdgeExtent = bHalfResolution ? FIntPoint::DivideAndRoundUp(SceneColor->Desc.Extent, 2) : SceneColor->Desc.Extent;
+
+        //Create edge texture(RG8, single-channel R8 on mobile)
+        const EPixelFormat EdgeFormat = IsMobilePath(View) ? PF_R8 : PF_R8G8B8A8;
+        const FRDGTextureDesc EdgeDesc = FRDGTextureDesc::Create2D(EdgeExtent, EdgeFormat, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_RenderTargetable);
         
-        FRDGTextureRef EdgeTexture = GraphBuilder.CreateTexture(EdgeDesc, TEXT("SMAA.Edges"));
+        FRDGTextureRef EdgeTexture = GraphBuilder.CreateTexture(EdgeDesc, bHalfResolution ? TEXT("SMAA.EdgesHalf") : TEXT("SMAA.Edges"));
+
+        //Half resolution steps two source pixels per tap so the bilinear sampler averages each 2x2 block
+        const float TexelStep = bHalfResolution ? 2.0f : 1.0f;
 
         //Setup shader params
         auto* PassParameters = GraphBuilder.AllocParameters<FSMAAEdgeDetectionPS::FParameters>();
@@ -67,22 +365,43 @@ namespace SMAARendering
         PassParameters->ColorSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp>::GetRHI();
         PassParameters->DepthTexture = SceneDepth; 
         PassParameters->DepthSampler = TStaticSamplerState<SF_Point, AM_Clamp, AM_Clamp>::GetRHI();
-        PassParameters->InvTextureSize = FVector2f(1.0f / SceneColor->Desc.Extent.X, 1.0f / SceneColor->Desc.Extent.Y);
+        PassParameters->InvTextureSize = FVector2f(TexelStep / SceneColor->Desc.Extent.X, TexelStep / SceneColor->Desc.Extent.Y);
         PassParameters->Threshold = Settings.EdgeDetectionThreshold;
-        PassParameters->EdgeDetectionMode = static_cast<uint32>(Settings.EdgeDetectionMode);
+        PassParameters->EdgeDetectionMode = static_cast<uint32>(EdgeDetectionMode);
+        PassParameters->bHDRInput = Settings.IsHDRInput() ? 1u : 0u;
         PassParameters->DebugMode = static_cast<uint32>(Settings.DebugMode);
-        PassParameters->RenderTargets[0] = FRenderTargetBinding(EdgeTexture, ERenderTargetLoadAction::EClear);
+        PassParameters->TileStateTexture = TileReuse.TileState;
+        if (Mask)
+        {
+            SetMaskParameters(GraphBuilder, PassParameters, *Mask, SceneColor->Desc.Extent, SceneColorRect, Settings);
+        }
+        if (bGeometric)
+        {
+            PassParameters->GBufferATexture = GBuffer.GBufferA;
+            PassParameters->GBufferBTexture = GBuffer.GBufferB;
+            PassParameters->SceneDepthTexture = GBuffer.SceneDepth;
+            PassParameters->GeometricNormalThreshold = Settings.GeometricNormalThreshold > 0.0f ? FMath::Cos(FMath::DegreesToRadians(Settings.GeometricNormalThreshold)) : -2.0f;
+            PassParameters->GeometricDepthThreshold = Settings.GeometricDepthThreshold;
+            GetUVToPixelTransform(SceneColor->Desc.Extent, SceneColorRect, GBuffer.ViewRect, PassParameters->GBufferUVToPixelScale, PassParameters->GBufferUVToPixelBias);
+        }
+        PassParameters->RenderTargets[0] = FRenderTargetBinding(EdgeTexture, GetLoadAction(View));
 
         // ---- Shaders ----
         //TShaderMapRef<FScreenPassVS> VertexShader(View.ShaderMap);
-        TShaderMapRef<FSMAAEdgeDetectionPS> PixelShader(View.ShaderMap);
+        FSMAAEdgeDetectionPS::FPermutationDomain PermutationVector;
+        PermutationVector.Set<FSMAAMobileDim>(IsMobilePath(View));
+        PermutationVector.Set<FSMAATileReuseDim>(TileReuse.IsValid());
+        PermutationVector.Set<FSMAAMaskDim>(Mask != nullptr);
+        PermutationVector.Set<FSMAAGeometricDim>(bGeometric);
+        TShaderMapRef<FSMAAEdgeDetectionPS> PixelShader(View.ShaderMap, PermutationVector);
+        SMAAPipelineCache::NotifyDraw(TEXT("EdgeDetection"), PixelShader.GetPixelShader(), EdgeDesc.Format);
 
         const FScreenPassTextureViewport OutputViewport(EdgeTexture);
         const FScreenPassTextureViewport InputViewport(SceneColor);
 
         AddDrawScreenPass(
             GraphBuilder,
-            RDG_EVENT_NAME("SMAA EdgeDetection"),
+            RDG_EVENT_NAME("SMAA EdgeDetection %dx%d", EdgeExtent.X, EdgeExtent.Y),
             View,
             OutputViewport,
             InputViewport,
@@ -90,18 +409,114 @@ namespace SMAARendering
             PassParameters
         );
 
+        if (bHalfResolution)
+        {
+            return AddEdgeUpsamplePass(GraphBuilder, View, EdgeTexture, SceneColor->Desc.Extent);
+        }
+
+        return EdgeTexture;
+    }
+
+    FRDGTextureRef AddEdgeDetectionComputePass(FRDGBuilder& GraphBuilder, const FViewInfo& View, FRDGTextureRef SceneColor, const FSMAASettings& Settings)
+    {
+        const FIntPoint Extent = SceneColor->Desc.Extent;
+
+        const FRDGTextureDesc EdgeDesc = FRDGTextureDesc::Create2D(Extent, PF_R8G8B8A8, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_RenderTargetable | TexCreate_UAV);
+
+        FRDGTextureRef EdgeTexture = GraphBuilder.CreateTexture(EdgeDesc, TEXT("SMAA.Edges"));
+
+        auto* PassParameters = GraphBuilder.AllocParameters<FSMAAEdgeDetectionCS::FParameters>();
+        PassParameters->ColorTexture = SceneColor;
+        PassParameters->TextureExtent = Extent;
+        PassParameters->Threshold = Settings.EdgeDetectionThreshold;
+        PassParameters->bHDRInput = Settings.IsHDRInput() ? 1u : 0u;
+        PassParameters->OutputTexture = GraphBuilder.CreateUAV(EdgeTexture);
+
+        TShaderMapRef<FSMAAEdgeDetectionCS> ComputeShader(View.ShaderMap);
+
+        FComputeShaderUtils::AddPass(
+            GraphBuilder,
+            RDG_EVENT_NAME("SMAA EdgeDetection (CS) %dx%d", Extent.X, Extent.Y),
+            ComputeShader,
+            PassParameters,
+            FComputeShaderUtils::GetGroupCount(Extent, FSMAAEdgeDetectionCS::ThreadGroupSize)
+        );
+
+        return EdgeTexture;
+    }
+
+    FRDGTextureRef AddEdgeUpsamplePass(FRDGBuilder& GraphBuilder, const FViewInfo& View, FRDGTextureRef SparseEdgeTexture, FIntPoint Extent)
+    {
+        const FRDGTextureDesc EdgeDesc = FRDGTextureDesc::Create2D(Extent, PF_R8G8B8A8, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_RenderTargetable);
+
+        FRDGTextureRef EdgeTexture = GraphBuilder.CreateTexture(EdgeDesc, TEXT("SMAA.Edges"));
+
+        auto* PassParameters = GraphBuilder.AllocParameters<FSMAAEdgeUpsamplePS::FParameters>();
+        PassParameters->EdgeTexture = SparseEdgeTexture;
+        PassParameters->RenderTargets[0] = FRenderTargetBinding(EdgeTexture, ERenderTargetLoadAction::EClear);
+
+        TShaderMapRef<FSMAAEdgeUpsamplePS> PixelShader(View.ShaderMap);
+        SMAAPipelineCache::NotifyDraw(TEXT("EdgeUpsample"), PixelShader.GetPixelShader(), EdgeDesc.Format);
+
+        const FScreenPassTextureViewport OutputViewport(EdgeTexture);
+        const FScreenPassTextureViewport InputViewport(SparseEdgeTexture);
+
+        AddDrawScreenPass(
+            GraphBuilder,
+            RDG_EVENT_NAME("SMAA EdgeUpsample"),
+            View,
+            OutputViewport,
+            InputViewport,
+            PixelShader,
+            PassParameters
+        );
 
         return EdgeTexture;
     }
 
-    FRDGTextureRef AddBlendingWeightPass(FRDGBuilder& GraphBuilder, const FViewInfo& View, FRDGTextureRef EdgeTexture, const FSMAASettings& Settings)
+    FSMAAPackedEdges AddEdgePackPass(FRDGBuilder& GraphBuilder, const FViewInfo& View, FRDGTextureRef EdgeTexture)
     {
+        const FIntPoint Extent = EdgeTexture->Desc.Extent;
+        const int32 WordBits = FSMAAEdgePackCS::ThreadGroupSize;
+
+        FSMAAPackedEdges PackedEdges;
+        PackedEdges.Horizontal = GraphBuilder.CreateTexture(
+            FRDGTextureDesc::Create2D(FIntPoint(FMath::DivideAndRoundUp(Extent.X, WordBits), Extent.Y), PF_R32_UINT, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV),
+            TEXT("SMAA.EdgesPackedH"));
+        PackedEdges.Vertical = GraphBuilder.CreateTexture(
+            FRDGTextureDesc::Create2D(FIntPoint(Extent.X, FMath::DivideAndRoundUp(Extent.Y, WordBits)), PF_R32_UINT, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV),
+            TEXT("SMAA.EdgesPackedV"));
+
+        auto* PassParameters = GraphBuilder.AllocParameters<FSMAAEdgePackCS::FParameters>();
+        PassParameters->EdgeTexture = EdgeTexture;
+        PassParameters->TextureExtent = Extent;
+        PassParameters->PackedEdgesH = GraphBuilder.CreateUAV(PackedEdges.Horizontal);
+        PassParameters->PackedEdgesV = GraphBuilder.CreateUAV(PackedEdges.Vertical);
+
+        TShaderMapRef<FSMAAEdgePackCS> ComputeShader(View.ShaderMap);
+
+        FComputeShaderUtils::AddPass(
+            GraphBuilder,
+            RDG_EVENT_NAME("SMAA EdgePack"),
+            ComputeShader,
+            PassParameters,
+            FComputeShaderUtils::GetGroupCount(Extent, FSMAAEdgePackCS::ThreadGroupSize)
+        );
+
+        return PackedEdges;
+    }
+
+    FRDGTextureRef AddBlendingWeightPass(FRDGBuilder& GraphBuilder, const FViewInfo& View, FRDGTextureRef EdgeTexture, const FSMAAPackedEdges& PackedEdges, const FSMAATileReuse& TileReuse, const FSMAASettings& Settings)
+    {
+        // Debug views are only implemented by the pixel shader
+        const bool bUseCompute = Settings.bUseComputeBlendingWeight && Settings.DebugMode == ESMAADebugMode::None;
+
         // Create blend weight texture (RGBA16F - 4 directional weights)
         const FRDGTextureDesc BlendDesc = FRDGTextureDesc::Create2D(
             EdgeTexture->Desc.Extent,
             PF_FloatRGBA,
             FClearValueBinding::Black,
-            TexCreate_ShaderResource | TexCreate_RenderTargetable
+            TexCreate_ShaderResource | TexCreate_RenderTargetable | (bUseCompute ? TexCreate_UAV : TexCreate_None)
         );
 
         FRDGTextureRef BlendTexture = GraphBuilder.CreateTexture(BlendDesc, TEXT("SMAA.BlendWeights"));
@@ -119,10 +534,41 @@ namespace SMAARendering
             GraphBuilder.RegisterExternalTexture(CreateRenderTarget(SearchTex->GetResource()->TextureRHI, TEXT("SMAA.SearchTex"))) :
             GraphBuilder.RegisterExternalTexture(GSystemTextures.WhiteDummy);
 
+        if (bUseCompute)
+        {
+            auto* PassParameters = GraphBuilder.AllocParameters<FSMAABlendingWeightCS::FParameters>();
+            PassParameters->EdgeTexture = EdgeTexture;
+            PassParameters->PackedEdgesH = PackedEdges.Horizontal;
+            PassParameters->PackedEdgesV = PackedEdges.Vertical;
+            PassParameters->AreaTexture = AreaTextureRDG;
+            PassParameters->AreaSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp>::GetRHI();
+            PassParameters->TextureExtent = EdgeTexture->Desc.Extent;
+            PassParameters->MaxSearchSteps = Settings.MaxSearchSteps;
+            PassParameters->OutputTexture = GraphBuilder.CreateUAV(BlendTexture);
+
+            FSMAABlendingWeightCS::FPermutationDomain PermutationVector;
+            PermutationVector.Set<FSMAAPackedEdgesDim>(PackedEdges.IsValid());
+            TShaderMapRef<FSMAABlendingWeightCS> ComputeShader(View.ShaderMap, PermutationVector);
+
+            FComputeShaderUtils::AddPass(
+                GraphBuilder,
+                RDG_EVENT_NAME("SMAA BlendWeight (CS)"),
+                ComputeShader,
+                PassParameters,
+                FComputeShaderUtils::GetGroupCount(EdgeTexture->Desc.Extent, FSMAABlendingWeightCS::ThreadGroupSize)
+            );
+
+            return BlendTexture;
+        }
+
         // Set up shader parameters
         auto* PassParameters = GraphBuilder.AllocParameters<FSMAABlendingWeightPS::FParameters>();
         PassParameters->EdgeTexture = EdgeTexture;
         PassParameters->EdgeSampler = TStaticSamplerState<SF_Point, AM_Clamp, AM_Clamp>::GetRHI();
+        PassParameters->PackedEdgesH = PackedEdges.Horizontal;
+        PassParameters->PackedEdgesV = PackedEdges.Vertical;
+        PassParameters->TileStateTexture = TileReuse.TileState;
+        PassParameters->HistoryBlendTexture = TileReuse.HistoryBlendWeights;
         PassParameters->AreaTexture = AreaTextureRDG;
         PassParameters->AreaSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp>::GetRHI();
         PassParameters->SearchTexture = SearchTextureRDG;
@@ -136,9 +582,14 @@ namespace SMAARendering
         PassParameters->bUseCornerDetection = Settings.bUseCornerDetection ? 1u : 0u;
         PassParameters->bUseDiagonalDetection = Settings.bUseDiagonalDetection ? 1u : 0u;
         PassParameters->DebugMode = static_cast<uint32>(Settings.DebugMode);
-        PassParameters->RenderTargets[0] = FRenderTargetBinding(BlendTexture, ERenderTargetLoadAction::EClear);
+        PassParameters->RenderTargets[0] = FRenderTargetBinding(BlendTexture, GetLoadAction(View));
 
-        TShaderMapRef<FSMAABlendingWeightPS> PixelShader(View.ShaderMap);
+        FSMAABlendingWeightPS::FPermutationDomain PermutationVector;
+        PermutationVector.Set<FSMAAPackedEdgesDim>(PackedEdges.IsValid());
+        PermutationVector.Set<FSMAAMobileDim>(IsMobilePath(View));
+        PermutationVector.Set<FSMAATileReuseDim>(TileReuse.IsValid());
+        TShaderMapRef<FSMAABlendingWeightPS> PixelShader(View.ShaderMap, PermutationVector);
+        SMAAPipelineCache::NotifyDraw(TEXT("BlendWeight"), PixelShader.GetPixelShader(), BlendDesc.Format);
 
         const FScreenPassTextureViewport OutputViewport(BlendTexture);
         const FScreenPassTextureViewport InputViewport(EdgeTexture);
@@ -180,9 +631,23 @@ namespace SMAARendering
             1.0f / SceneColor->Desc.Extent.Y
         );
         PassParameters->DebugMode = static_cast<uint32>(Settings.DebugMode);
-        PassParameters->RenderTargets[0] = FRenderTargetBinding(OutputTexture, ERenderTargetLoadAction::EClear);
-
-        TShaderMapRef<FSMAANeighborhoodBlendingPS> PixelShader(View.ShaderMap);
+        PassParameters->SharpenAmount = Settings.SharpenAmount;
+        PassParameters->GrainIntensity = Settings.GrainIntensity;
+        PassParameters->FrameIndex = View.Family->FrameNumber;
+        PassParameters->RenderTargets[0] = FRenderTargetBinding(OutputTexture, GetLoadAction(View));
+
+        // Debug views output the visualization untouched
+        // The fused stages expect display referred [0, 1] color, linear HDR input (before the tonemapper) skips them
+        const bool bFusedStages = !IsMobilePath(View) && Settings.DebugMode == ESMAADebugMode::None && !Settings.IsHDRInput();
+
+        FSMAANeighborhoodBlendingPS::FPermutationDomain PermutationVector;
+        PermutationVector.Set<FSMAAMobileDim>(IsMobilePath(View));
+        PermutationVector.Set<FSMAAFusedSharpenDim>(bFusedStages && Settings.SharpenAmount > 0.0f);
+        PermutationVector.Set<FSMAAFusedGrainDim>(bFusedStages && Settings.GrainIntensity > 0.0f);
+        PermutationVector.Set<FSMAAFusedDitherDim>(bFusedStages && Settings.bDither);
+        PermutationVector.Set<FSMAAFusedColorConversionDim>(bFusedStages ? static_cast<int32>(Settings.ColorConversion) : 0);
+        TShaderMapRef<FSMAANeighborhoodBlendingPS> PixelShader(View.ShaderMap, PermutationVector);
+        SMAAPipelineCache::NotifyDraw(TEXT("Neighborhood"), PixelShader.GetPixelShader(), OutputDesc.Format);
         const FScreenPassTextureViewport OutputViewport(OutputTexture);
         const FScreenPassTextureViewport InputViewport(SceneColor);
 
@@ -198,5 +663,54 @@ namespace SMAARendering
         return OutputTexture;
     }
 
-}
+    void AddSMAAUpscalePass(FRDGBuilder& GraphBuilder, const FViewInfo& View, const FScreenPassTexture& SceneColor, FRDGTextureRef BlendWeights, const FScreenPassRenderTarget& Output, const FSMAASettings& Settings)
+    {
+        RDG_EVENT_SCOPE(GraphBuilder, "SMAA");
+
+        const FIntRect InputRect = SceneColor.ViewRect;
+        const FIntRect OutputRect = Output.ViewRect;
+
+        auto* PassParameters = GraphBuilder.AllocParameters<FSMAANeighborhoodUpscalePS::FParameters>();
+        PassParameters->ColorTexture = SceneColor.Texture;
+        PassParameters->ColorSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp>::GetRHI();
+        PassParameters->BlendTexture = BlendWeights ? BlendWeights : GSystemTextures.GetBlackDummy(GraphBuilder);
+        PassParameters->BlendSampler = TStaticSamplerState<SF_Point, AM_Clamp, AM_Clamp>::GetRHI();
+        PassParameters->InvTextureSize = FVector2f(
+            1.0f / SceneColor.Texture->Desc.Extent.X,
+            1.0f / SceneColor.Texture->Desc.Extent.Y
+        );
+        PassParameters->OutputViewMin = FVector2f(OutputRect.Min);
+        PassParameters->OutputToInputScale = FVector2f(
+            float(InputRect.Width()) / OutputRect.Width(),
+            float(InputRect.Height()) / OutputRect.Height()
+        );
+        PassParameters->InputViewMin = FVector2f(InputRect.Min);
+        PassParameters->InputViewMax = FVector2f(InputRect.Max);
+        PassParameters->SharpenAmount = Settings.SharpenAmount;
+        PassParameters->GrainIntensity = Settings.GrainIntensity;
+        PassParameters->FrameIndex = View.Family->FrameNumber;
+        PassParameters->RenderTargets[0] = Output.GetRenderTargetBinding();
+
+        FSMAANeighborhoodUpscalePS::FPermutationDomain PermutationVector;
+        PermutationVector.Set<FSMAAFusedSharpenDim>(Settings.SharpenAmount > 0.0f);
+        PermutationVector.Set<FSMAAFusedGrainDim>(Settings.GrainIntensity > 0.0f);
+        PermutationVector.Set<FSMAAFusedDitherDim>(Settings.bDither);
+        PermutationVector.Set<FSMAAFusedColorConversionDim>(static_cast<int32>(Settings.ColorConversion));
+        TShaderMapRef<FSMAANeighborhoodUpscalePS> PixelShader(View.ShaderMap, PermutationVector);
+        SMAAPipelineCache::NotifyDraw(TEXT("NeighborhoodUpscale"), PixelShader.GetPixelShader(), Output.Texture->Desc.Format);
+
+        const FScreenPassTextureViewport OutputViewport(Output);
+        const FScreenPassTextureViewport InputViewport(SceneColor);
+
+        AddDrawScreenPass(
+            GraphBuilder,
+            RDG_EVENT_NAME("SMAA NeighborhoodUpscale %dx%d -> %dx%d", InputRect.Width(), InputRect.Height(), OutputRect.Width(), OutputRect.Height()),
+            View,
+            OutputViewport,
+            InputViewport,
+            PixelShader,
+            PassParameters
+        );
+    }
 
+}
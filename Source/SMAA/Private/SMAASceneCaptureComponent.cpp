@@ -0,0 +1,100 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SMAASceneCaptureComponent.h"
+#include "Components/SceneCaptureComponent.h"
+#include "GameFramework/Actor.h"
+#include "Misc/ScopeLock.h"
+#include "SceneView.h"
+
+namespace SMAASceneCaptures
+{
+    static FCriticalSection GCapturesLock;
+    static TMap<uint32, ESMAAQualityPreset> GCaptures;
+
+    void Register(uint32 ViewKey, ESMAAQualityPreset QualityPreset)
+    {
+        FScopeLock Lock(&GCapturesLock);
+        GCaptures.Add(ViewKey, QualityPreset);
+    }
+
+    void Unregister(uint32 ViewKey)
+    {
+        FScopeLock Lock(&GCapturesLock);
+        GCaptures.Remove(ViewKey);
+    }
+
+    bool Find(uint32 ViewKey, ESMAAQualityPreset& OutQualityPreset)
+    {
+        FScopeLock Lock(&GCapturesLock);
+        if (const ESMAAQualityPreset* QualityPreset = GCaptures.Find(ViewKey))
+        {
+            OutQualityPreset = *QualityPreset;
+            return true;
+        }
+        return false;
+    }
+}
+
+USMAASceneCaptureComponent::USMAASceneCaptureComponent()
+{
+    // Captures render at the end of the frame, registering after the update keeps the key current for them
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+    bTickInEditor = true;
+}
+
+void USMAASceneCaptureComponent::OnRegister()
+{
+    Super::OnRegister();
+
+    // Captures only keep a view state (and with it a stable view key) when asked to
+    if (USceneCaptureComponent* Capture = ResolveSceneCapture())
+    {
+        Capture->bAlwaysPersistRenderingState = true;
+    }
+}
+
+void USMAASceneCaptureComponent::OnUnregister()
+{
+    if (RegisteredViewKey != 0)
+    {
+        SMAASceneCaptures::Unregister(RegisteredViewKey);
+        RegisteredViewKey = 0;
+    }
+
+    Super::OnUnregister();
+}
+
+void USMAASceneCaptureComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    USceneCaptureComponent* Capture = ResolveSceneCapture();
+    FSceneViewStateInterface* ViewState = Capture ? Capture->GetViewState(0) : nullptr;
+    const uint32 ViewKey = (bEnableSMAA && ViewState) ? ViewState->GetViewKey() : 0;
+
+    // The view state is created lazily by the first capture and recreated when the capture changes
+    if (ViewKey != RegisteredViewKey && RegisteredViewKey != 0)
+    {
+        SMAASceneCaptures::Unregister(RegisteredViewKey);
+    }
+    if (ViewKey != 0)
+    {
+        SMAASceneCaptures::Register(ViewKey, QualityPreset);
+    }
+    RegisteredViewKey = ViewKey;
+}
+
+USceneCaptureComponent* USMAASceneCaptureComponent::ResolveSceneCapture()
+{
+    if (!SceneCapture && GetOwner())
+    {
+        SceneCapture = GetOwner()->FindComponentByClass<USceneCaptureComponent>();
+        if (SceneCapture)
+        {
+            SceneCapture->bAlwaysPersistRenderingState = true;
+        }
+    }
+    return SceneCapture;
+}
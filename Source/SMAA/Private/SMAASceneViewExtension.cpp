@@ -4,20 +4,109 @@
 #include "SMAASceneViewExtension.h"
 #include "SMAARendering.h"
 #include "SMAASettings.h"
+#include "SMAASceneCaptureComponent.h"
+#include "SMAAViewSettings.h"
+#include "SMAASpatialUpscaler.h"
+#include "SMAACapture.h"
 #include "PostProcess/PostProcessing.h"
 #include "PostProcess/PostProcessMaterial.h"
 #include "SceneView.h"
 #include "SceneViewExtension.h"
 #include "SceneViewExtensionContext.h"
+#include "SceneRenderTargetParameters.h"
+#include "RenderUtils.h"
 
 
 
 
+namespace
+{
+    // Maps the r.SMAA.InsertionPoint setting to the post processing pass we subscribe to
+    ISceneViewExtension::EPostProcessingPass GetPostProcessingPass(ESMAAInsertionPoint InsertionPoint)
+    {
+        switch (InsertionPoint)
+        {
+        case ESMAAInsertionPoint::MotionBlur:
+            return ISceneViewExtension::EPostProcessingPass::MotionBlur;
+        case ESMAAInsertionPoint::FXAA:
+            return ISceneViewExtension::EPostProcessingPass::FXAA;
+        case ESMAAInsertionPoint::VisualizeDepthOfField:
+            return ISceneViewExtension::EPostProcessingPass::VisualizeDepthOfField;
+        case ESMAAInsertionPoint::Tonemap:
+        default:
+            return ISceneViewExtension::EPostProcessingPass::Tonemap;
+        }
+    }
+
+    // Game thread counterpart of the checks in PostProcessPassCallback_RenderThread (after SetupView)
+    bool WillRenderSMAA(const FSceneView& View, const FSMAASettings& Settings)
+    {
+        if (!SMAARendering::ShouldRenderSMAA(View))
+        {
+            return false;
+        }
+
+        if (Settings.InsertionPoint == ESMAAInsertionPoint::FXAA && View.AntiAliasingMethod != AAM_None)
+        {
+            return false;
+        }
+
+        FSMAASettings ViewSettings = Settings;
+        SMAAViewSettings::ApplyOverrides(View, ViewSettings);
+        return ViewSettings.bEnabled;
+    }
+}
+
 SMAASceneViewExtension::SMAASceneViewExtension(const FAutoRegister& InAutoRegister) : FSceneViewExtensionBase(InAutoRegister)
 {
     UE_LOG(LogTemp, Log, TEXT("SMAA Scene View Extension created"));
 }
 
+void SMAASceneViewExtension::SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView)
+{
+    FSMAASettings Settings = FSMAASettings::GetRuntimeSettings();
+
+    // SMAA takes FXAA's slot, running both would blur the image twice
+    if (Settings.bEnabled && Settings.InsertionPoint == ESMAAInsertionPoint::FXAA && InView.AntiAliasingMethod == AAM_FXAA)
+    {
+        InView.AntiAliasingMethod = AAM_None;
+    }
+
+    // Captures opted into SMAA don't also pay for temporal AA and its per-capture history
+    ESMAAQualityPreset CaptureQualityPreset;
+    if (Settings.bEnabled && InView.bIsSceneCapture && InView.State
+        && SMAASceneCaptures::Find(InView.State->GetViewKey(), CaptureQualityPreset)
+        && (InView.AntiAliasingMethod == AAM_TemporalAA || InView.AntiAliasingMethod == AAM_TSR))
+    {
+        InView.AntiAliasingMethod = AAM_None;
+    }
+}
+
+
+void SMAASceneViewExtension::BeginRenderViewFamily(FSceneViewFamily& InViewFamily)
+{
+    FSMAASettings Settings = FSMAASettings::GetRuntimeSettings();
+
+    // Only used by views the renderer upscales spatially, temporal upscalers bypass it.
+    // Weights only line up with the image at or after the tonemapper, and debug views hand none over -
+    // installing it there would just swap the engine's upscale filter for plain bilinear.
+    // The same goes for families where no view runs SMAA (captures that did not opt in, views switched off).
+    const bool bAnyViewRendersSMAA = InViewFamily.Views.ContainsByPredicate([&Settings](const FSceneView* View)
+    {
+        return View && WillRenderSMAA(*View, Settings);
+    });
+
+    if (Settings.bEnabled
+        && bAnyViewRendersSMAA
+        && Settings.bUpscale
+        && !Settings.IsHDRInput()
+        && Settings.DebugMode == ESMAADebugMode::None
+        && InViewFamily.GetFeatureLevel() >= ERHIFeatureLevel::SM5
+        && InViewFamily.GetPrimarySpatialUpscalerInterface() == nullptr)
+    {
+        InViewFamily.SetPrimarySpatialUpscalerInterface(new FSMAASpatialUpscaler());
+    }
+}
 
 FScreenPassTexture SMAASceneViewExtension::PostProcessPassCallback_RenderThread(FRDGBuilder& GraphBuilder, const FSceneView& View, const FPostProcessMaterialInputs& Inputs)
 {
@@ -67,6 +156,29 @@ FScreenPassTexture SMAASceneViewExtension::PostProcessPassCallback_RenderThread(
     //     SceneDepth = FScreenPassTexture((*Inputs.SceneTextures)->SceneDepthTexture, SceneColor.ViewRect);
     // }
 
+    // Custom depth/stencil for r.SMAA.Mask, the scene textures are at render resolution
+    SMAARendering::FSMAAMaskTextures MaskTextures;
+    if (Settings.MaskMode != ESMAAMaskMode::None && Inputs.SceneTextures.SceneTextures)
+    {
+        const FSceneTextureUniformParameters* SceneTextureParameters = Inputs.SceneTextures.SceneTextures->GetParameters();
+        MaskTextures.CustomDepth = SceneTextureParameters->CustomDepthTexture;
+        MaskTextures.CustomStencil = SceneTextureParameters->CustomStencilTexture;
+        MaskTextures.ViewRect = ViewInfo.ViewRect;
+    }
+
+    // GBuffer for geometric edge detection, only written by the deferred renderer
+    SMAARendering::FSMAAGBufferTextures GBufferTextures;
+    if (Settings.EdgeDetectionMode == ESMAAEdgeDetectionMode::Geometric
+        && Inputs.SceneTextures.SceneTextures
+        && !IsForwardShadingEnabled(ViewInfo.GetShaderPlatform()))
+    {
+        const FSceneTextureUniformParameters* SceneTextureParameters = Inputs.SceneTextures.SceneTextures->GetParameters();
+        GBufferTextures.GBufferA = SceneTextureParameters->GBufferATexture;
+        GBufferTextures.GBufferB = SceneTextureParameters->GBufferBTexture;
+        GBufferTextures.SceneDepth = SceneTextureParameters->SceneDepthTexture;
+        GBufferTextures.ViewRect = ViewInfo.ViewRect;
+    }
+
     if (!SceneColor.IsValid() || !Settings.bEnabled)
     {
         return SceneColor;
@@ -77,34 +189,122 @@ FScreenPassTexture SMAASceneViewExtension::PostProcessPassCallback_RenderThread(
         return SceneColor;
     }
 
-    return SMAARendering::AddSMAAPasses(
+    // The FXAA slot is subscribed for every view, but only views whose FXAA was swapped out in SetupView
+    // take SMAA (views on TAA/TSR are already anti-aliased)
+    if (Settings.InsertionPoint == ESMAAInsertionPoint::FXAA && ViewInfo.AntiAliasingMethod != AAM_None)
+    {
+        if (Inputs.OverrideOutput.IsValid())
+        {
+            AddDrawTexturePass(GraphBuilder, ViewInfo, SceneColor, Inputs.OverrideOutput);
+            return FScreenPassTexture(Inputs.OverrideOutput);
+        }
+        return SceneColor;
+    }
+
+    // Scene captures run at their own preset
+    ESMAAQualityPreset CaptureQualityPreset;
+    if (ViewInfo.bIsSceneCapture && ViewInfo.State && SMAASceneCaptures::Find(ViewInfo.State->GetViewKey(), CaptureQualityPreset))
+    {
+        Settings.ApplyQualityPreset(CaptureQualityPreset);
+    }
+
+    // Post process volume and camera overrides of this view (USMAAViewSettings blendables)
+    SMAAViewSettings::ApplyOverrides(ViewInfo, Settings);
+    if (!Settings.bEnabled)
+    {
+        return SceneColor;
+    }
+
+    // Views without a persistent state (e.g. one-off renders) have nothing to reuse
+    SMAARendering::FSMAAViewHistory* History = nullptr;
+    if (Settings.bReuseStaticTiles && ViewInfo.State)
+    {
+        TUniquePtr<SMAARendering::FSMAAViewHistory>& Entry = ViewHistories.FindOrAdd(ViewInfo.State->GetViewKey());
+        if (!Entry.IsValid())
+        {
+            Entry = MakeUnique<SMAARendering::FSMAAViewHistory>();
+        }
+        History = Entry.Get();
+    }
+
+    // Spatially upscaled views leave neighborhood blending to the SMAA upscaler, which writes the output
+    // resolution directly (the weights only line up with the image until the tonemapper, so not before it)
+    const FSMAASpatialUpscaler* Upscaler = FSMAASpatialUpscaler::Find(*ViewInfo.Family);
+    if (Upscaler
+        && Settings.bUpscale
+        && ViewInfo.PrimaryScreenPercentageMethod == EPrimaryScreenPercentageMethod::SpatialUpscale
+        && !Settings.IsHDRInput()
+        && Settings.DebugMode == ESMAADebugMode::None
+        && ViewInfo.GetFeatureLevel() >= ERHIFeatureLevel::SM5)
+    {
+        FRDGTextureRef BlendWeights = SMAARendering::AddSMAABlendingWeightPasses(GraphBuilder, ViewInfo, SceneColor, SceneDepth, Settings, History, MaskTextures, GBufferTextures);
+        Upscaler->SetBlendWeights(ViewInfo, BlendWeights, Settings);
+
+        if (Inputs.OverrideOutput.IsValid())
+        {
+            AddDrawTexturePass(GraphBuilder, ViewInfo, SceneColor, Inputs.OverrideOutput);
+            return FScreenPassTexture(Inputs.OverrideOutput);
+        }
+        return SceneColor;
+    }
+
+    FScreenPassTexture Output = SMAARendering::AddSMAAPasses(
         GraphBuilder,
         ViewInfo,
         SceneColor,
         SceneDepth,
-        Settings
+        Settings,
+        History,
+        MaskTextures,
+        GBufferTextures
     );
 
+    // When SMAA is the last pass of the chain (e.g. after FXAA/VisualizeDepthOfField)
+    // the renderer hands us the final target and expects us to write into it
+    if (Inputs.OverrideOutput.IsValid())
+    {
+        AddDrawTexturePass(GraphBuilder, ViewInfo, Output, Inputs.OverrideOutput);
+        return FScreenPassTexture(Inputs.OverrideOutput);
+    }
+
+    return Output;
+
 }
 
 
 void SMAASceneViewExtension::PostRenderViewFamily_RenderThread(FRHICommandListImmediate& RHICmdList, FSceneViewFamily& InViewFamily)
 {
     UE_LOG(LogTemp, Warning, TEXT("SMAA: PostRenderViewFamily_RenderThread called"));
+
+    // Finished r.SMAA.Capture readbacks are handed to the writer task
+    SMAACapture::Tick_RenderThread();
+
+    // Release histories of views that stopped rendering (closed viewports, destroyed captures)
+    const uint32 MaxHistoryAge = 60;
+    for (auto It = ViewHistories.CreateIterator(); It; ++It)
+    {
+        if (InViewFamily.FrameNumber - It.Value()->LastFrameNumber > MaxHistoryAge)
+        {
+            It.RemoveCurrent();
+        }
+    }
 }
 
 void SMAASceneViewExtension::SubscribeToPostProcessingPass(EPostProcessingPass PassId, FAfterPassCallbackDelegateArray& InOutPassCallbacks, bool bIsPassEnabled)
 {
     UE_LOG(LogTemp, Warning, TEXT("SMAA: SubscribeToPostProcessingPass called for pass %d"), (int32)PassId);
 
-    // Subscribe to Tonemap pass
-    if (PassId == EPostProcessingPass::Tonemap)
+    FSMAASettings Settings = FSMAASettings::GetRuntimeSettings();
+
+    // Subscribe to the configured insertion point (Tonemap by default)
+    if (PassId == GetPostProcessingPass(Settings.InsertionPoint))
     {
-        FSMAASettings Settings = FSMAASettings::GetRuntimeSettings();
-        if (Settings.bEnabled && bIsPassEnabled)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("SMAA: Adding callback to Tonemap pass"));
+        // FXAA is switched off in SetupView when we replace it, so its slot is not required to be enabled
+        // (the callback then skips views that never ran FXAA, see PostProcessPassCallback_RenderThread)
+        const bool bReplacesPass = Settings.InsertionPoint == ESMAAInsertionPoint::FXAA;
 
+        if (Settings.bEnabled && (bIsPassEnabled || bReplacesPass))
+        {
             InOutPassCallbacks.Add(FAfterPassCallbackDelegate::CreateRaw(
                 this,
                 &SMAASceneViewExtension::PostProcessPassCallback_RenderThread
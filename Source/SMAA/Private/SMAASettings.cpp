@@ -14,6 +14,17 @@ static TAutoConsoleVariable<int32> CVarSMAAEnable(
 	ECVF_RenderThreadSafe
 );
 
+static TAutoConsoleVariable<int32> CVarSMAAInsertionPoint(
+    TEXT("r.SMAA.InsertionPoint"),
+    1,
+    TEXT("Post processing pass SMAA runs after\n")
+    TEXT("0: MotionBlur            - Before tonemap on HDR input, bloom/DOF consume the anti-aliased image\n")
+    TEXT("1: Tonemap               - After tonemap (default)\n")
+    TEXT("2: FXAA                  - Replaces FXAA on views that use it\n")
+    TEXT("3: VisualizeDepthOfField - End of the post process chain\n"),
+    ECVF_RenderThreadSafe
+);
+
 static TAutoConsoleVariable<int32> CVarSMAAQuality(
     TEXT("r.SMAA.Quality"),
     2,
@@ -31,7 +42,47 @@ static TAutoConsoleVariable<int32> CVarSMAAEdgeDetectionMode(
     TEXT("SMAA edge detection method\n")
     TEXT("0: Luma  - Luminance based (default, fastest)\n")
     TEXT("1: Color - RGB color difference\n")
-    TEXT("2: Depth - Depth buffer based\n"),
+    TEXT("2: Depth - Depth buffer based\n")
+    TEXT("3: Geometric - GBuffer depth discontinuities and shading model (normals optional), ignores texture detail\n")
+    TEXT("   (deferred shading only, falls back to Luma elsewhere)\n"),
+    ECVF_RenderThreadSafe
+);
+
+static TAutoConsoleVariable<float> CVarSMAAGeometricNormalThreshold(
+    TEXT("r.SMAA.GeometricNormalThreshold"),
+    0.0f,
+    TEXT("Geometric edge detection: minimum angle in degrees between the normals of neighboring pixels\n")
+    TEXT("0: No crease test (default) - GBuffer normals include normal maps, small angles bring texture detail back\n")
+    TEXT("45-60 adds hard surface creases without reacting to typical normal maps\n"),
+    ECVF_RenderThreadSafe
+);
+
+static TAutoConsoleVariable<float> CVarSMAAGeometricDepthThreshold(
+    TEXT("r.SMAA.GeometricDepthThreshold"),
+    0.05f,
+    TEXT("Geometric edge detection: depth discontinuity between neighboring pixels, relative to the nearer one (default 0.05)\n")
+    TEXT("Measured against the depth extrapolated along the surface, so slanted and grazing-angle floors don't form edges\n"),
+    ECVF_RenderThreadSafe
+);
+
+static TAutoConsoleVariable<int32> CVarSMAAEdgeDetectionResolution(
+    TEXT("r.SMAA.EdgeDetectionResolution"),
+    0,
+    TEXT("Resolution of the SMAA edge detection pass\n")
+    TEXT("0: Full         - Every pixel is tested (default)\n")
+    TEXT("1: Half         - Tests 2x2 block averages, edge mask is upsampled conservatively\n")
+    TEXT("Half reduces edge pass bandwidth at 4K and above at the cost of some thin-edge recall\n"),
+    ECVF_RenderThreadSafe
+);
+
+static TAutoConsoleVariable<int32> CVarSMAAEdgeDetectionCompute(
+    TEXT("r.SMAA.EdgeDetectionCompute"),
+    0,
+    TEXT("Run luma edge detection as a compute shader\n")
+    TEXT("Each pixel's luma is fetched and computed once and shared through groupshared memory\n")
+    TEXT("Only used with Luma mode at full edge detection resolution\n")
+    TEXT("0: Disabled (default)\n")
+    TEXT("1: Enabled\n"),
     ECVF_RenderThreadSafe
 );
 
@@ -50,25 +101,129 @@ static TAutoConsoleVariable<int32> CVarSMAAMaxSearchSteps(
     32,
     TEXT("Maximum search steps for edge pattern detection\n")
     TEXT("Higher = better quality but slower\n")
-    TEXT("Default: 32\n"),
+    TEXT("Overrides the r.SMAA.Quality preset's steps when set\n"),
+    ECVF_RenderThreadSafe
+);
+
+static TAutoConsoleVariable<int32> CVarSMAABlendingWeightCompute(
+    TEXT("r.SMAA.BlendingWeightCompute"),
+    0,
+    TEXT("Run the blending weight pass as a tiled compute shader\n")
+    TEXT("Edges are bit-packed into groupshared memory and searched from there,\n")
+    TEXT("only lines leaving the tile fall back to texture fetches\n")
+    TEXT("0: Disabled (default)\n")
+    TEXT("1: Enabled\n"),
+    ECVF_RenderThreadSafe
+);
+
+static TAutoConsoleVariable<int32> CVarSMAAPackedEdges(
+    TEXT("r.SMAA.PackedEdges"),
+    0,
+    TEXT("Pack edges into 32 bits per R32_UINT texel for the blending weight searches\n")
+    TEXT("Line ends are found 32 pixels per fetch, making large MaxSearchSteps nearly free\n")
+    TEXT("0: Disabled (default)\n")
+    TEXT("1: Enabled\n"),
+    ECVF_RenderThreadSafe
+);
+
+static TAutoConsoleVariable<int32> CVarSMAAReuseStaticTiles(
+    TEXT("r.SMAA.ReuseStaticTiles"),
+    0,
+    TEXT("Reuse last frame's blend weights on tiles whose scene color did not change\n")
+    TEXT("Edges and weights are only recomputed near changed tiles (per-tile hash pass, includes the r.SMAA.Mask selection and the GBuffer inputs of geometric edges)\n")
+    TEXT("0: Disabled (default)\n")
+    TEXT("1: Enabled\n"),
+    ECVF_RenderThreadSafe
+);
+
+static TAutoConsoleVariable<int32> CVarSMAAMask(
+    TEXT("r.SMAA.Mask"),
+    0,
+    TEXT("Restricts SMAA to part of the view, masked out pixels are rejected in the edge detection pass\n")
+    TEXT("0: None          - Whole view (default)\n")
+    TEXT("1: CustomStencil - Pixels whose custom stencil matches r.SMAA.MaskStencil\n")
+    TEXT("2: CustomDepth   - Pixels covered by primitives that render custom depth\n")
+    TEXT("Requires r.CustomDepth 3 for the stencil mask\n"),
+    ECVF_RenderThreadSafe
+);
+
+static TAutoConsoleVariable<int32> CVarSMAAMaskStencil(
+    TEXT("r.SMAA.MaskStencil"),
+    0,
+    TEXT("Custom stencil bits selecting pixels for r.SMAA.Mask 1 (0 = any non-zero stencil value)\n"),
+    ECVF_RenderThreadSafe
+);
+
+static TAutoConsoleVariable<int32> CVarSMAAMaskInvert(
+    TEXT("r.SMAA.MaskInvert"),
+    0,
+    TEXT("0: Anti-alias the selected pixels (default)\n")
+    TEXT("1: Anti-alias everything except the selected pixels\n"),
+    ECVF_RenderThreadSafe
+);
+
+static TAutoConsoleVariable<int32> CVarSMAAUpscale(
+    TEXT("r.SMAA.Upscale"),
+    0,
+    TEXT("SMAA-aware spatial upscale for views below 100 screen percentage (without temporal upscaling)\n")
+    TEXT("Weights are computed at render resolution, neighborhood blending writes the upscaled output\n")
+    TEXT("0: Disabled (default) - the engine upscales the anti-aliased image\n")
+    TEXT("1: Enabled - replaces the engine's primary spatial upscale pass\n")
+    TEXT("Needs an insertion point at or after the tonemapper. Only installed on families with a view SMAA runs on,\n")
+    TEXT("other views sharing such a family get a plain bilinear upscale instead of r.Upscale.Quality\n"),
+    ECVF_RenderThreadSafe
+);
+
+static TAutoConsoleVariable<float> CVarSMAASharpen(
+    TEXT("r.SMAA.Sharpen"),
+    0.0f,
+    TEXT("Contrast adaptive sharpening fused into the neighborhood blending pass (0 = off, 1 = max)\n")
+    TEXT("Replaces a separate sharpening pass, blended pixels are left unsharpened\n")
+    TEXT("Like the other fused stages it is skipped with r.SMAA.InsertionPoint 0 (linear HDR input)\n"),
+    ECVF_RenderThreadSafe
+);
+
+static TAutoConsoleVariable<float> CVarSMAAGrain(
+    TEXT("r.SMAA.Grain"),
+    0.0f,
+    TEXT("Film grain intensity fused into the neighborhood blending pass (0 = off)\n"),
+    ECVF_RenderThreadSafe
+);
+
+static TAutoConsoleVariable<int32> CVarSMAADither(
+    TEXT("r.SMAA.Dither"),
+    0,
+    TEXT("Dither the neighborhood blending output by one 8 bit step to hide banding\n")
+    TEXT("0: Disabled (default)\n")
+    TEXT("1: Enabled\n"),
+    ECVF_RenderThreadSafe
+);
+
+static TAutoConsoleVariable<int32> CVarSMAAColorConversion(
+    TEXT("r.SMAA.ColorConversion"),
+    0,
+    TEXT("Color space conversion fused into the end of the neighborhood blending pass\n")
+    TEXT("0: None (default)\n")
+    TEXT("1: Linear to sRGB\n")
+    TEXT("2: sRGB to linear\n"),
     ECVF_RenderThreadSafe
 );
 
 static TAutoConsoleVariable<int32> CVarSMAACornerDetection(
     TEXT("r.SMAA.CornerDetection"),
     1,
-    TEXT("Enable corner detection\n")
+    TEXT("Enable corner detection, overrides the r.SMAA.Quality preset when set\n")
     TEXT("0: Disabled\n")
-    TEXT("1: Enabled (default)\n"),
+    TEXT("1: Enabled\n"),
     ECVF_RenderThreadSafe
 );
 
 static TAutoConsoleVariable<int32> CVarSMAADiagonalDetection(
     TEXT("r.SMAA.DiagonalDetection"),
     1,
-    TEXT("Enable diagonal edge detection\n")
+    TEXT("Enable diagonal edge detection, overrides the r.SMAA.Quality preset when set\n")
     TEXT("0: Disabled\n")
-    TEXT("1: Enabled (default)\n"),
+    TEXT("1: Enabled\n"),
     ECVF_RenderThreadSafe
 );
 
@@ -93,19 +248,59 @@ SMAASettings::~SMAASettings()
 {
 }
 
+// Search cvars left at their defaults keep the quality preset's values
+template<typename T>
+static bool IsSetExplicitly(const TAutoConsoleVariable<T>& CVar)
+{
+    return (CVar->GetFlags() & ECVF_SetByMask) > ECVF_SetByConstructor;
+}
+
 FSMAASettings FSMAASettings::GetRuntimeSettings()
 {
     FSMAASettings Settings;
 
     Settings.bEnabled = CVarSMAAEnable.GetValueOnAnyThread() != 0;
-    Settings.QualityPreset = static_cast<ESMAAQualityPreset>(FMath::Clamp(CVarSMAAEdgeDetectionMode.GetValueOnAnyThread(), 0, 3));
-    Settings.EdgeDetectionMode = static_cast<ESMAAEdgeDetectionMode>(FMath::Clamp(CVarSMAAEdgeDetectionMode.GetValueOnAnyThread(), 0, 2));
+    Settings.InsertionPoint = static_cast<ESMAAInsertionPoint>(FMath::Clamp(CVarSMAAInsertionPoint.GetValueOnAnyThread(), 0, 3));
+    Settings.ApplyQualityPreset(static_cast<ESMAAQualityPreset>(FMath::Clamp(CVarSMAAQuality.GetValueOnAnyThread(), 0, 3)));
+    Settings.EdgeDetectionMode = static_cast<ESMAAEdgeDetectionMode>(FMath::Clamp(CVarSMAAEdgeDetectionMode.GetValueOnAnyThread(), 0, 3));
+    Settings.EdgeDetectionResolution = static_cast<ESMAAEdgeDetectionResolution>(FMath::Clamp(CVarSMAAEdgeDetectionResolution.GetValueOnAnyThread(), 0, 1));
+    Settings.bUseComputeEdgeDetection = CVarSMAAEdgeDetectionCompute.GetValueOnAnyThread() != 0;
     Settings.EdgeDetectionThreshold = FMath::Clamp(CVarSMAAThreshold.GetValueOnAnyThread(), 0.01f, 0.5f);
-    Settings.MaxSearchSteps = FMath::Clamp(CVarSMAAMaxSearchSteps.GetValueOnAnyThread(), 0, 112);
-    Settings.bUseCornerDetection = CVarSMAACornerDetection.GetValueOnAnyThread() != 0;
-    Settings.bUseDiagonalDetection = CVarSMAADiagonalDetection.GetValueOnAnyThread() != 0;
+    Settings.GeometricNormalThreshold = FMath::Clamp(CVarSMAAGeometricNormalThreshold.GetValueOnAnyThread(), 0.0f, 90.0f);
+    Settings.GeometricDepthThreshold = FMath::Clamp(CVarSMAAGeometricDepthThreshold.GetValueOnAnyThread(), 0.001f, 1.0f);
+    if (IsSetExplicitly(CVarSMAAMaxSearchSteps))
+    {
+        Settings.MaxSearchSteps = FMath::Clamp(CVarSMAAMaxSearchSteps.GetValueOnAnyThread(), 0, 112);
+    }
+    Settings.bUseComputeBlendingWeight = CVarSMAABlendingWeightCompute.GetValueOnAnyThread() != 0;
+    Settings.bUsePackedEdges = CVarSMAAPackedEdges.GetValueOnAnyThread() != 0;
+    Settings.bReuseStaticTiles = CVarSMAAReuseStaticTiles.GetValueOnAnyThread() != 0;
+    Settings.MaskMode = static_cast<ESMAAMaskMode>(FMath::Clamp(CVarSMAAMask.GetValueOnAnyThread(), 0, 2));
+    Settings.MaskStencilMask = FMath::Clamp(CVarSMAAMaskStencil.GetValueOnAnyThread(), 0, 255);
+    Settings.bInvertMask = CVarSMAAMaskInvert.GetValueOnAnyThread() != 0;
+    Settings.bUpscale = CVarSMAAUpscale.GetValueOnAnyThread() != 0;
+    Settings.SharpenAmount = FMath::Clamp(CVarSMAASharpen.GetValueOnAnyThread(), 0.0f, 1.0f);
+    Settings.GrainIntensity = FMath::Clamp(CVarSMAAGrain.GetValueOnAnyThread(), 0.0f, 1.0f);
+    Settings.bDither = CVarSMAADither.GetValueOnAnyThread() != 0;
+    Settings.ColorConversion = static_cast<ESMAAColorConversion>(FMath::Clamp(CVarSMAAColorConversion.GetValueOnAnyThread(), 0, 2));
+    if (IsSetExplicitly(CVarSMAACornerDetection))
+    {
+        Settings.bUseCornerDetection = CVarSMAACornerDetection.GetValueOnAnyThread() != 0;
+    }
+    if (IsSetExplicitly(CVarSMAADiagonalDetection))
+    {
+        Settings.bUseDiagonalDetection = CVarSMAADiagonalDetection.GetValueOnAnyThread() != 0;
+    }
     Settings.DebugMode = static_cast<ESMAADebugMode>(FMath::Clamp(CVarSMAADebugMode.GetValueOnAnyThread(), 0, 6));
 
     
     return Settings;
 }
+
+void FSMAASettings::ApplyQualityPreset(ESMAAQualityPreset Preset)
+{
+    QualityPreset = Preset;
+    MaxSearchSteps = Preset == ESMAAQualityPreset::Low ? 16 : 32;
+    bUseCornerDetection = Preset >= ESMAAQualityPreset::High;
+    bUseDiagonalDetection = Preset == ESMAAQualityPreset::Ultra;
+}
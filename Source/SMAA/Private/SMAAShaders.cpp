@@ -4,6 +4,20 @@
 #include "SMAAShaders.h"
 #include "ShaderParameterUtils.h"
 #include "RenderGraphUtils.h"
+#include "DataDrivenShaderPlatformInfo.h"
+
+void ModifySMAACompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+{
+    // Edges, weights and area lookups are all 8 bit data, half precision is plenty
+    // (keyed on the platform alone - a cvar read here would not be part of the shader map key)
+    if (FDataDrivenShaderPlatformInfo::GetSupportsRealTypes(Parameters.Platform) == ERHIFeatureSupport::RuntimeGuaranteed)
+    {
+        OutEnvironment.SetDefine(TEXT("SMAA_USE_FP16"), 1);
+        OutEnvironment.CompilerFlags.Add(CFLAG_AllowRealTypes);
+    }
+
+    OutEnvironment.SetDefine(TEXT("SMAA_REUSE_TILE_SIZE"), SMAAReuseTileSize);
+}
 
 //Implementing the shader classes
 
@@ -13,13 +27,47 @@ IMPLEMENT_GLOBAL_SHADER(FSMAAEdgeDetectionPS,
     "MainPS",                                       // Entry point function name
     SF_Pixel);                                      // Shader frequency (pixel shader)
 
+IMPLEMENT_GLOBAL_SHADER(FSMAAEdgeDetectionCS,
+    "/Plugin/SMAA/Private/SMAAEdgeDetection.usf",
+    "MainCS",
+    SF_Compute);
+
+IMPLEMENT_GLOBAL_SHADER(FSMAAEdgeUpsamplePS,
+    "/Plugin/SMAA/Private/SMAAEdgeDetection.usf",
+    "UpsamplePS",
+    SF_Pixel);
+
+IMPLEMENT_GLOBAL_SHADER(FSMAAEdgePackCS,
+    "/Plugin/SMAA/Private/SMAAEdgePack.usf",
+    "MainCS",
+    SF_Compute);
+
 IMPLEMENT_GLOBAL_SHADER(FSMAABlendingWeightPS,
     "/Plugin/SMAA/Private/SMAABlendingWeight.usf",
     "MainPS",
     SF_Pixel);
 
+IMPLEMENT_GLOBAL_SHADER(FSMAABlendingWeightCS,
+    "/Plugin/SMAA/Private/SMAABlendingWeight.usf",
+    "MainCS",
+    SF_Compute);
+
+IMPLEMENT_GLOBAL_SHADER(FSMAATileHashCS,
+    "/Plugin/SMAA/Private/SMAATileReuse.usf",
+    "HashCS",
+    SF_Compute);
+
+IMPLEMENT_GLOBAL_SHADER(FSMAATileClassifyCS,
+    "/Plugin/SMAA/Private/SMAATileReuse.usf",
+    "ClassifyCS",
+    SF_Compute);
+
 IMPLEMENT_GLOBAL_SHADER(FSMAANeighborhoodBlendingPS,
     "/Plugin/SMAA/Private/SMAANeighborhoodBlending.usf",
     "MainPS",
     SF_Pixel);
 
+IMPLEMENT_GLOBAL_SHADER(FSMAANeighborhoodUpscalePS,
+    "/Plugin/SMAA/Private/SMAANeighborhoodBlending.usf",
+    "UpscalePS",
+    SF_Pixel);
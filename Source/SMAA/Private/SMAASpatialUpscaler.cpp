@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SMAASpatialUpscaler.h"
+#include "SMAARendering.h"
+#include "SceneRendering.h"
+
+const TCHAR* const FSMAASpatialUpscaler::DebugName = TEXT("SMAASpatialUpscaler");
+
+UE::Renderer::Private::ISpatialUpscaler* FSMAASpatialUpscaler::Fork_GameThread(const FSceneViewFamily& ViewFamily) const
+{
+    return new FSMAASpatialUpscaler();
+}
+
+FScreenPassTexture FSMAASpatialUpscaler::AddPasses(FRDGBuilder& GraphBuilder, const FViewInfo& View, const FInputs& PassInputs) const
+{
+    check(PassInputs.SceneColor.IsValid());
+
+    FScreenPassRenderTarget Output = PassInputs.OverrideOutput;
+    if (!Output.IsValid())
+    {
+        const FIntRect OutputRect = PassInputs.Stage == EUpscaleStage::PrimaryToSecondary
+            ? FIntRect(FIntPoint::ZeroValue, View.GetSecondaryViewRectSize())
+            : View.UnscaledViewRect;
+
+        FRDGTextureDesc OutputDesc = PassInputs.SceneColor.Texture->Desc;
+        OutputDesc.Reset();
+        OutputDesc.Extent = OutputRect.Max;
+        OutputDesc.Flags |= TexCreate_ShaderResource | TexCreate_RenderTargetable;
+        OutputDesc.ClearValue = FClearValueBinding::Black;
+
+        Output = FScreenPassRenderTarget(GraphBuilder.CreateTexture(OutputDesc, TEXT("SMAA.Upscaled")), OutputRect, View.GetOverwriteLoadAction());
+    }
+
+    // Views SMAA did not run on (or ran on a different input) still get a plain bilinear upscale
+    FRDGTextureRef BlendWeights = nullptr;
+    FSMAASettings Settings = FSMAASettings::GetRuntimeSettings();
+    if (const FViewInputs* Inputs = ViewInputs.Find(&View))
+    {
+        if (Inputs->BlendWeights && Inputs->BlendWeights->Desc.Extent == PassInputs.SceneColor.Texture->Desc.Extent)
+        {
+            BlendWeights = Inputs->BlendWeights;
+        }
+        Settings = Inputs->Settings;
+        ViewInputs.Remove(&View);
+    }
+
+    SMAARendering::AddSMAAUpscalePass(GraphBuilder, View, PassInputs.SceneColor, BlendWeights, Output, Settings);
+
+    return FScreenPassTexture(Output);
+}
+
+void FSMAASpatialUpscaler::SetBlendWeights(const FViewInfo& View, FRDGTextureRef BlendWeights, const FSMAASettings& Settings) const
+{
+    FViewInputs& Inputs = ViewInputs.FindOrAdd(&View);
+    Inputs.BlendWeights = BlendWeights;
+    Inputs.Settings = Settings;
+}
+
+const FSMAASpatialUpscaler* FSMAASpatialUpscaler::Find(const FSceneViewFamily& ViewFamily)
+{
+    const UE::Renderer::Private::ISpatialUpscaler* Upscaler = ViewFamily.GetPrimarySpatialUpscalerInterface();
+    if (Upscaler && FCString::Strcmp(Upscaler->GetDebugName(), DebugName) == 0)
+    {
+        return static_cast<const FSMAASpatialUpscaler*>(Upscaler);
+    }
+    return nullptr;
+}
@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SMAAViewSettings.h"
+#include "SceneView.h"
+
+namespace
+{
+    // Blendable data pushed per USMAAViewSettings into the view's final post process settings.
+    // A copy taken on the game thread - the render thread never touches the UObject, which the
+    // game thread or editor may be editing or collecting meanwhile.
+    struct FSMAAViewSettingsData
+    {
+        bool bOverride_bEnabled = false;
+        bool bOverride_QualityPreset = false;
+        bool bOverride_EdgeDetectionThreshold = false;
+        bool bOverride_MaxSearchSteps = false;
+
+        bool bEnabled = true;
+        ESMAAQualityPreset QualityPreset = ESMAAQualityPreset::High;
+        float EdgeDetectionThreshold = 0.1f;
+        int32 MaxSearchSteps = 32;
+
+        float Weight = 0.0f;
+
+        static FName GetFName()
+        {
+            static const FName Name(TEXT("FSMAAViewSettingsData"));
+            return Name;
+        }
+    };
+}
+
+USMAAViewSettings::USMAAViewSettings()
+    : bOverride_bEnabled(false)
+    , bOverride_QualityPreset(false)
+    , bOverride_EdgeDetectionThreshold(false)
+    , bOverride_MaxSearchSteps(false)
+{
+}
+
+void USMAAViewSettings::OverrideBlendableSettings(FSceneView& View, float Weight) const
+{
+    FSMAAViewSettingsData Data;
+    Data.bOverride_bEnabled = bOverride_bEnabled;
+    Data.bOverride_QualityPreset = bOverride_QualityPreset;
+    Data.bOverride_EdgeDetectionThreshold = bOverride_EdgeDetectionThreshold;
+    Data.bOverride_MaxSearchSteps = bOverride_MaxSearchSteps;
+    Data.bEnabled = bEnabled;
+    Data.QualityPreset = QualityPreset;
+    Data.EdgeDetectionThreshold = FMath::Clamp(EdgeDetectionThreshold, 0.01f, 0.5f);
+    Data.MaxSearchSteps = FMath::Clamp(MaxSearchSteps, 0, 112);
+    Data.Weight = FMath::Clamp(Weight, 0.0f, 1.0f);
+    View.FinalPostProcessSettings.BlendableManager.PushBlendableData(Data.Weight, Data);
+}
+
+namespace SMAAViewSettings
+{
+    void ApplyOverrides(const FSceneView& View, FSMAASettings& InOutSettings)
+    {
+        // Entries come in blend order (volumes by priority, then the camera), later ones win.
+        // Discrete settings switch at half weight, continuous ones are interpolated.
+        FBlendableEntry* Iterator = nullptr;
+        while (const FSMAAViewSettingsData* Data = View.FinalPostProcessSettings.BlendableManager.IterateBlendables<FSMAAViewSettingsData>(Iterator))
+        {
+            if (Data->Weight <= 0.0f)
+            {
+                continue;
+            }
+
+            const bool bDiscrete = Data->Weight >= 0.5f;
+
+            if (Data->bOverride_bEnabled && bDiscrete)
+            {
+                InOutSettings.bEnabled = InOutSettings.bEnabled && Data->bEnabled;
+            }
+            if (Data->bOverride_QualityPreset && bDiscrete)
+            {
+                InOutSettings.ApplyQualityPreset(Data->QualityPreset);
+            }
+            if (Data->bOverride_EdgeDetectionThreshold)
+            {
+                InOutSettings.EdgeDetectionThreshold = FMath::Lerp(InOutSettings.EdgeDetectionThreshold, Data->EdgeDetectionThreshold, Data->Weight);
+            }
+            if (Data->bOverride_MaxSearchSteps)
+            {
+                InOutSettings.MaxSearchSteps = FMath::RoundToInt(FMath::Lerp(float(InOutSettings.MaxSearchSteps), float(Data->MaxSearchSteps), Data->Weight));
+            }
+        }
+    }
+}
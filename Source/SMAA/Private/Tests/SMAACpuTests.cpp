@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SMAACpu.h"
+#include "ImageCore.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SMAACpuTests
+{
+    // Hard-edged shapes (diagonal, near-horizontal and near-vertical lines) over a smooth gradient.
+    // Shape contrast is far above and the gradient far below the threshold, so half precision
+    // rounding never decides whether an edge exists, only how the result is computed
+    static FImage MakeTestImage()
+    {
+        const int32 Size = 96;
+        FImage Image(Size, Size, ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+        TArrayView64<FLinearColor> Pixels = Image.AsRGBA32F();
+
+        for (int32 Y = 0; Y < Size; ++Y)
+        {
+            for (int32 X = 0; X < Size; ++X)
+            {
+                const float Gradient = 0.2f + 0.1f * float(X + Y) / float(2 * Size);
+                FLinearColor Color(Gradient, Gradient, Gradient, 1.0f);
+
+                if (X > Y / 3 + 20 && X < 70)
+                {
+                    Color = FLinearColor(0.9f, 0.8f, 0.1f, 1.0f);
+                }
+                if (Y > X / 5 + 55)
+                {
+                    Color = FLinearColor(0.05f, 0.3f, 0.9f, 1.0f);
+                }
+                if (X + Y > 150)
+                {
+                    Color = FLinearColor(1.0f, 1.0f, 1.0f, 1.0f);
+                }
+
+                Pixels[Y * Size + X] = Color;
+            }
+        }
+
+        return Image;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSMAACpuHalfPrecisionTest, "Plugins.SMAA.Cpu.HalfPrecision",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+/**
+ * Emulates the SMAA_USE_FP16 shaders on the CPU: every output must stay within one 8 bit code of full precision
+ */
+bool FSMAACpuHalfPrecisionTest::RunTest(const FString& Parameters)
+{
+    for (ESMAAEdgeDetectionMode Mode : { ESMAAEdgeDetectionMode::Luma, ESMAAEdgeDetectionMode::Color })
+    {
+        FSMAASettings Settings;
+        Settings.EdgeDetectionMode = Mode;
+
+        FImage FullPrecision = SMAACpuTests::MakeTestImage();
+        FImage HalfPrecision = SMAACpuTests::MakeTestImage();
+        SMAACpu::Process(FullPrecision, false, Settings, false);
+        SMAACpu::Process(HalfPrecision, false, Settings, true);
+
+        TArrayView64<const FLinearColor> FullPixels = FullPrecision.AsRGBA32F();
+        TArrayView64<const FLinearColor> HalfPixels = HalfPrecision.AsRGBA32F();
+
+        int32 MaxDifference = 0;
+        for (int64 Index = 0; Index < FullPixels.Num(); ++Index)
+        {
+            const FColor Full = FullPixels[Index].ToFColorSRGB();
+            const FColor Half = HalfPixels[Index].ToFColorSRGB();
+            MaxDifference = FMath::Max(MaxDifference, FMath::Abs(int32(Full.R) - int32(Half.R)));
+            MaxDifference = FMath::Max(MaxDifference, FMath::Abs(int32(Full.G) - int32(Half.G)));
+            MaxDifference = FMath::Max(MaxDifference, FMath::Abs(int32(Full.B) - int32(Half.B)));
+        }
+
+        TestTrue(FString::Printf(TEXT("Mode %d: half precision output within one 8 bit code (max difference %d)"), static_cast<int32>(Mode), MaxDifference), MaxDifference <= 1);
+    }
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
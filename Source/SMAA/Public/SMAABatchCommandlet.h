@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SMAABatchCommandlet.generated.h"
+
+/**
+ * Offline SMAA for captured image sequences (PNG/EXR), no GPU required
+ *
+ * Usage:
+ *   UnrealEditor-Cmd <Project> -run=SMAABatch -Input=<Dir> -Output=<Dir> [-MaxInFlight=N] -nullrhi
+ *
+ * Frames stream through decode, anti-alias and encode tasks on the task graph.
+ * At most MaxInFlight frames are alive at once, so memory stays flat for any sequence length.
+ * Quality settings come from the r.SMAA.* console variables (e.g. via -ExecCmds or DefaultEngine.ini).
+ */
+UCLASS()
+class USMAABatchCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USMAABatchCommandlet();
+
+	//UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenderGraphDefinitions.h"
+
+class FRDGBuilder;
+class FViewInfo;
+
+/**
+ * SMAA intermediate capture for offline analysis (r.SMAA.Capture N)
+ *
+ * Copies SMAA.Edges and SMAA.BlendWeights of the next N frames through GPU readbacks
+ * (never stalling the render thread) together with per-pass GPU timestamps, then writes
+ * the images, edge density histograms and timings to Saved/SMAA/Captures on a background task.
+ */
+namespace SMAACapture
+{
+    // One view of one captured frame, in flight between the GPU and the writer task
+    struct FFrame;
+
+    /**
+     * Starts capturing the view when frames were requested, returns null otherwise
+     * (every other call accepts a null frame and does nothing)
+     */
+    FFrame* BeginFrame(FRDGBuilder& GraphBuilder, const FViewInfo& View);
+
+    /**
+     * Timestamps the end of the pass just added
+     */
+    void MarkPass(FRDGBuilder& GraphBuilder, FFrame* Frame, const TCHAR* PassName);
+
+    /**
+     * Queues readbacks of the intermediates
+     */
+    void CaptureTextures(FRDGBuilder& GraphBuilder, FFrame* Frame, FRDGTextureRef EdgeTexture, FRDGTextureRef BlendWeightTexture);
+
+    /**
+     * Hands the frame over to polling, it is written once all readbacks and timestamps landed
+     */
+    void EndFrame(FFrame* Frame);
+
+    /**
+     * Polls in-flight captures without waiting and launches writer tasks for finished ones (render thread)
+     */
+    void Tick_RenderThread();
+}
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SMAASettings.h"
+
+struct FImage;
+
+/**
+ * SMAA CPU implementation - the three GPU passes for offline use
+ * (render farm nodes without a GPU, see USMAABatchCommandlet)
+ *
+ * Edge detection follows the GPU thresholds, but the blending weights come from an analytic
+ * line area instead of the AreaTex lookup (crossing edge shapes are not distinguished), so
+ * the output approximates in-engine SMAA rather than matching it
+ *
+ * bHalfPrecision rounds the intermediates the SMAA_USE_FP16 shaders keep in half precision
+ * (colors, luma, edge deltas, weights, blend results), so the FP16 path can be checked on the CPU
+ */
+namespace SMAACpu
+{
+    // Edge bits per pixel, matching the R/G channels of SMAA.Edges
+    enum EEdgeBits : uint8
+    {
+        EdgeLeft = 1 << 0,
+        EdgeTop = 1 << 1,
+    };
+
+    /**
+     * Pass 1 - detects left/top edges
+     *
+     * @param Image - RGBA32F image
+     * @param bHDRInput - Image holds linear HDR values (compressed to a perceptual range before testing)
+     * @param OutEdges - One EEdgeBits mask per pixel
+     */
+    SMAA_API void DetectEdges(const FImage& Image, bool bHDRInput, const FSMAASettings& Settings, TArray<uint8>& OutEdges, bool bHalfPrecision = false);
+
+    /**
+     * Pass 2 - blending weights per pixel
+     * XY = top edge weights (own side, neighbor side), ZW = left edge weights
+     */
+    SMAA_API void CalculateBlendingWeights(const TArray<uint8>& Edges, int32 Width, int32 Height, const FSMAASettings& Settings, TArray<FVector4f>& OutWeights, bool bHalfPrecision = false);
+
+    /**
+     * Pass 3 - blends each pixel with its dominant neighbor in place
+     */
+    SMAA_API void BlendNeighborhood(FImage& Image, const TArray<FVector4f>& Weights, bool bHalfPrecision = false);
+
+    /**
+     * Runs all three passes on an RGBA32F image in place
+     */
+    SMAA_API void Process(FImage& Image, bool bHDRInput, const FSMAASettings& Settings, bool bHalfPrecision = false);
+}
@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PixelFormat.h"
+
+class FRHIPixelShader;
+
+/**
+ * SMAA PSO precaching - creates the pipelines of every SMAA pass up front
+ * so enabling SMAA or switching modes does not hitch on first use
+ */
+namespace SMAAPipelineCache
+{
+    /**
+     * Precaches graphics pipelines for every pass, permutation and render target
+     * format SMAA may hit, plus the compute pipelines. Called once after engine init,
+     * the neighborhood pipelines are precached again when the fused stage or upscale cvars change.
+     */
+    void PrecachePipelines();
+
+    /**
+     * Called at draw time for each SMAA screen pass - checks the engine's PSO cache once per pipeline
+     * and logs and counts those that are still compiling or were missed (created late)
+     */
+    void NotifyDraw(const TCHAR* PassName, FRHIPixelShader* PixelShader, EPixelFormat RenderTargetFormat);
+
+    /**
+     * Number of distinct SMAA pipelines created at draw time so far
+     */
+    int32 GetNumLatePipelines();
+}
@@ -15,6 +15,52 @@ class FViewInfo;
   */
 namespace SMAARendering
 {
+    /**
+     * Per-view state kept between frames for static tile reuse (r.SMAA.ReuseStaticTiles)
+     */
+    struct FSMAAViewHistory
+    {
+        // Last frame's blending weights, complete for every tile
+        TRefCountPtr<IPooledRenderTarget> BlendWeights;
+
+        // Last frame's scene color hash per SMAAReuseTileSize tile
+        TRefCountPtr<IPooledRenderTarget> TileHashes;
+
+        // History is only valid for the same extent and settings
+        FIntPoint Extent = FIntPoint::ZeroValue;
+        uint32 SettingsHash = 0;
+
+        // Used to drop histories of views that stopped rendering
+        uint32 LastFrameNumber = 0;
+    };
+
+    /**
+     * Custom depth/stencil of the view for r.SMAA.Mask, at render resolution
+     */
+    struct FSMAAMaskTextures
+    {
+        FRDGTextureRef CustomDepth = nullptr;
+        FRDGTextureSRVRef CustomStencil = nullptr;
+
+        // Region of the view inside the custom depth texture
+        FIntRect ViewRect;
+    };
+
+    /**
+     * GBuffer of the view for geometric edge detection, at render resolution
+     */
+    struct FSMAAGBufferTextures
+    {
+        FRDGTextureRef GBufferA = nullptr;
+        FRDGTextureRef GBufferB = nullptr;
+        FRDGTextureRef SceneDepth = nullptr;
+
+        // Region of the view inside the GBuffer
+        FIntRect ViewRect;
+
+        bool IsValid() const { return GBufferA && GBufferB && SceneDepth; }
+    };
+
     /**
      * Main entry point - adds all SMAA passes to the render graph
      *
@@ -22,6 +68,9 @@ namespace SMAARendering
      * @param View - Current view being rendered
      * @param SceneColor - Input scene color texture (before SMAA)
      * @param Settings - SMAA configuration settings
+     * @param History - Optional per-view history, enables static tile reuse
+     * @param MaskTextures - Custom depth/stencil for masked SMAA, the mask is ignored when missing
+     * @param GBufferTextures - GBuffer for geometric edge detection, luma is used when missing
      * @return Anti-aliased output texture
      */
     FScreenPassTexture AddSMAAPasses(
@@ -29,12 +78,47 @@ namespace SMAARendering
         const FViewInfo& View,
         const FScreenPassTexture& SceneColor,
         const FScreenPassTexture& SceneDepth,
+        const FSMAASettings& Settings,
+        FSMAAViewHistory* History = nullptr,
+        const FSMAAMaskTextures& MaskTextures = FSMAAMaskTextures(),
+        const FSMAAGBufferTextures& GBufferTextures = FSMAAGBufferTextures()
+    );
+
+    /**
+     * Edge detection and blending weight passes only, for a neighborhood blending pass that runs later
+     *
+     * @return Blending weights at the resolution of SceneColor
+     */
+    FRDGTextureRef AddSMAABlendingWeightPasses(
+        FRDGBuilder& GraphBuilder,
+        const FViewInfo& View,
+        const FScreenPassTexture& SceneColor,
+        const FScreenPassTexture& SceneDepth,
+        const FSMAASettings& Settings,
+        FSMAAViewHistory* History = nullptr,
+        const FSMAAMaskTextures& MaskTextures = FSMAAMaskTextures(),
+        const FSMAAGBufferTextures& GBufferTextures = FSMAAGBufferTextures()
+    );
+
+    /**
+     * Neighborhood blending that writes straight to an upscaled output (SMAA-aware spatial upscale)
+     *
+     * @param SceneColor - Render resolution color the weights were computed on
+     * @param BlendWeights - Weights from AddSMAABlendingWeightPasses, null for a plain bilinear upscale
+     * @param Output - Upscaled target and view rect
+     */
+    void AddSMAAUpscalePass(
+        FRDGBuilder& GraphBuilder,
+        const FViewInfo& View,
+        const FScreenPassTexture& SceneColor,
+        FRDGTextureRef BlendWeights,
+        const FScreenPassRenderTarget& Output,
         const FSMAASettings& Settings
     );
 
     /**
      * Check if SMAA should render for this view
      */
-    bool ShouldRenderSMAA(const FViewInfo& View);
+    bool ShouldRenderSMAA(const FSceneView& View);
 }
 
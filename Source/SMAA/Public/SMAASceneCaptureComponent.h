@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "SMAASettings.h"
+#include "SMAASceneCaptureComponent.generated.h"
+
+class USceneCaptureComponent;
+
+/**
+ * Opts a scene capture (security camera monitors, minimaps, ...) into SMAA
+ *
+ * Add it to the actor owning the capture component. Scene captures are skipped by SMAA
+ * unless they carry this component, which also picks their own quality preset and
+ * switches off temporal AA on the capture, so secondary views get history-free
+ * anti-aliasing at a fraction of the cost.
+ */
+UCLASS(ClassGroup = Rendering, meta = (BlueprintSpawnableComponent))
+class SMAA_API USMAASceneCaptureComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	USMAASceneCaptureComponent();
+
+	// Whether the capture is anti-aliased with SMAA
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SMAA")
+	bool bEnableSMAA = true;
+
+	// Quality preset of the capture, independent of r.SMAA.Quality
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SMAA")
+	ESMAAQualityPreset QualityPreset = ESMAAQualityPreset::Low;
+
+	// Capture to anti-alias, the first scene capture component of the owner when not set
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SMAA")
+	TObjectPtr<USceneCaptureComponent> SceneCapture;
+
+	//UActorComponent interface
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+	USceneCaptureComponent* ResolveSceneCapture();
+
+	// View key the capture was registered with, 0 when not registered
+	uint32 RegisteredViewKey = 0;
+};
+
+/**
+ * Registry of scene captures opted into SMAA, keyed by the capture's view state key
+ * Written on the game thread, read on the game and render threads
+ */
+namespace SMAASceneCaptures
+{
+	void Register(uint32 ViewKey, ESMAAQualityPreset QualityPreset);
+	void Unregister(uint32 ViewKey);
+
+	// Whether the capture view with this key renders SMAA, and at which preset
+	bool Find(uint32 ViewKey, ESMAAQualityPreset& OutQualityPreset);
+}
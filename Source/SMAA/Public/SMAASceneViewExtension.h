@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "SceneViewExtension.h"
+#include "SMAARendering.h"
 
 /**
  * Scene View Extension - Injects SMAA into the rendering pipeline
@@ -18,8 +19,8 @@ public:
 
 	//FSceneViewExtentionBase interface
 	virtual void SetupViewFamily(FSceneViewFamily& InViewFamily) override {}
-	virtual void SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView) override {}
-	virtual void BeginRenderViewFamily(FSceneViewFamily& InViewFamily) override {}
+	virtual void SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView) override;
+	virtual void BeginRenderViewFamily(FSceneViewFamily& InViewFamily) override;
 
 	virtual void PostRenderViewFamily_RenderThread(
 		FRHICommandListImmediate& RHICmdList,
@@ -45,4 +46,6 @@ private:
 		const FPostProcessMaterialInputs& Inputs
 	);
 
+	// Static tile reuse history per view state (render thread only)
+	TMap<uint32, TUniquePtr<SMAARendering::FSMAAViewHistory>> ViewHistories;
 };
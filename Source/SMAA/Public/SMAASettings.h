@@ -3,12 +3,13 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "SMAASettings.generated.h"
 
 /**
  * SMAA Quality Presets
  * These control search distances and prediction settings
  */
-
+UENUM(BlueprintType)
 enum class ESMAAQualityPreset : uint8
 {
 	Low = 0,	//16 max serach steps
@@ -26,6 +27,50 @@ enum class ESMAAEdgeDetectionMode : uint8
 	Luma = 0,	//Luminance based (fastest)
 	Color = 1,	//RGB color difference(better for colored edges)
 	Depth = 2,	//Depth based(good for geometry edges)
+	Geometric = 3,	//GBuffer depth, shading model and optionally normals (ignores texture detail, deferred shading only)
+};
+
+/**
+ * SMAA Edge Detection Resolution
+ * Trades thin-edge recall for edge pass bandwidth on high DPI targets
+ */
+enum class ESMAAEdgeDetectionResolution : uint8
+{
+	Full = 0,			//Every pixel runs the full edge detection (default)
+	Half = 1,			//Detect on 2x2 block averages, then upsample the edge mask
+};
+
+/**
+ * SMAA Post Process Insertion Point
+ * Post processing pass SMAA runs after
+ */
+enum class ESMAAInsertionPoint : uint8
+{
+	MotionBlur = 0,				//Before tonemap, HDR input (bloom/DOF see the anti-aliased image)
+	Tonemap = 1,				//After tonemap (default)
+	FXAA = 2,					//Replaces FXAA
+	VisualizeDepthOfField = 3,	//End of the post process chain
+};
+
+/**
+ * SMAA Mask Mode
+ * Restricts SMAA to part of the view, masked out pixels are rejected in the edge pass
+ */
+enum class ESMAAMaskMode : uint8
+{
+	None = 0,			//Whole view (default)
+	CustomStencil = 1,	//Pixels whose custom stencil matches MaskStencilMask
+	CustomDepth = 2,	//Pixels covered by primitives that render custom depth
+};
+
+/**
+ * Color space conversion fused into the end of neighborhood blending
+ */
+enum class ESMAAColorConversion : uint8
+{
+	None = 0,			//Output keeps the input encoding (default)
+	LinearToSRGB = 1,	//Encode linear input for an sRGB display target
+	SRGBToLinear = 2,	//Decode sRGB input for a linear target
 };
 
 /**
@@ -59,11 +104,69 @@ struct FSMAASettings
 
     ESMAADebugMode DebugMode = ESMAADebugMode::None;
 
+    // Post processing pass SMAA runs after
+    ESMAAInsertionPoint InsertionPoint = ESMAAInsertionPoint::Tonemap;
+
+    // Resolution the edge detection pass runs at
+    // Half adds a cheap upsample pass but skips three quarters of the color taps
+    ESMAAEdgeDetectionResolution EdgeDetectionResolution = ESMAAEdgeDetectionResolution::Full;
+
+    // Whether luma edge detection runs as a compute shader that shares luma through groupshared memory
+    // Each pixel's luma is fetched and computed once instead of three times
+    bool bUseComputeEdgeDetection = false;
+
+    // Whether blending weights are computed from bit-packed edge tiles in groupshared memory
+    // Cuts memory traffic of the search-heavy second pass, debug views keep the pixel shader
+    bool bUseComputeBlendingWeight = false;
+
+    // Whether the edge pass also produces bit-packed edges (32 per texel)
+    // Searches then find line ends 32 pixels per fetch, making large MaxSearchSteps cheap
+    bool bUsePackedEdges = false;
+
+    // Whether views with history reuse last frame's blend weights on tiles far from any scene color change
+    // Saves most of the edge and weight cost on static frames (editor viewports, menus, paused games)
+    bool bReuseStaticTiles = false;
+
+    // Restricts SMAA to pixels selected by custom depth/stencil
+    ESMAAMaskMode MaskMode = ESMAAMaskMode::None;
+
+    // Stencil bits that select a pixel (CustomStencil mask), 0 selects any non-zero value
+    int32 MaskStencilMask = 0;
+
+    // Anti-alias everything except the selected pixels (e.g. to exclude video surfaces or UI in world)
+    bool bInvertMask = false;
+
+    // Whether spatially upscaled views (screen percentage below 100 without a temporal upscaler)
+    // run neighborhood blending straight into the output resolution in place of the engine's upscale pass
+    bool bUpscale = false;
+
+    // Post stages fused into the neighborhood blending pass, replacing separate full screen passes
+    // (display referred only, skipped when the input is linear HDR)
+    // Contrast adaptive sharpening strength (0 = off, 1 = max)
+    float SharpenAmount = 0.0f;
+
+    // Film grain intensity (0 = off)
+    float GrainIntensity = 0.0f;
+
+    // Triangular 8 bit dither of the output
+    bool bDither = false;
+
+    // Final color space conversion of the output
+    ESMAAColorConversion ColorConversion = ESMAAColorConversion::None;
+
     // Edge detection threshold (0.05 - 0.15 typical range)
     // Lower = more edges detected = more blurring
     // Higher = fewer edges = sharper but more aliasing
     float EdgeDetectionThreshold = 0.1f;
 
+    // Geometric edge detection: minimum angle between neighboring normals (degrees, 0 = no crease test)
+    // Off by default, normal mapped GBuffer normals would bring texture detail back
+    float GeometricNormalThreshold = 0.0f;
+
+    // Geometric edge detection: depth discontinuity relative to the nearer pixel, measured against
+    // the depth predicted from the surface's own depth gradient
+    float GeometricDepthThreshold = 0.05f;
+
     // Local contrast adaptation factor (0.0 - 1.0)
     // Higher values make threshold adapt to local contrast
     float LocalContrastAdaptationFactor = 2.0f;
@@ -80,6 +183,12 @@ struct FSMAASettings
     // Slightly more expensive but prevents corner rounding
     bool bUseCornerDetection = true;
 
+    // Sets search steps, corner and diagonal detection from a quality preset
+    void ApplyQualityPreset(ESMAAQualityPreset Preset);
+
+    // Whether SMAA sees linear HDR scene color (inserted before the tonemapper)
+    bool IsHDRInput() const { return InsertionPoint == ESMAAInsertionPoint::MotionBlur; }
+
     // Get settings from console variables
     static FSMAASettings GetRuntimeSettings();
 };
@@ -7,6 +7,36 @@
 #include "ShaderParameterStruct.h"
 #include "RenderGraphUtils.h"
 
+// Low-cost ES3.1 path: mediump math, single-channel edges, reduced search steps
+class FSMAAMobileDim : SHADER_PERMUTATION_BOOL("SMAA_MOBILE");
+
+// Mobile permutations only compile for mobile platforms, the others need SM5
+inline bool ShouldCompileSMAAPermutation(const FGlobalShaderPermutationParameters& Parameters, bool bMobile)
+{
+    return bMobile ? IsMobilePlatform(Parameters.Platform) : IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+}
+
+// Static tile reuse: edges/weights are only recomputed near tiles whose scene color changed
+class FSMAATileReuseDim : SHADER_PERMUTATION_BOOL("SMAA_TILE_REUSE");
+
+// Restricts edge detection to pixels selected by custom depth/stencil
+class FSMAAMaskDim : SHADER_PERMUTATION_BOOL("SMAA_MASK");
+
+// Geometric edge detection from GBuffer normals, depth and shading model instead of scene color
+class FSMAAGeometricDim : SHADER_PERMUTATION_BOOL("SMAA_GEOMETRIC");
+
+// Post stages fused into neighborhood blending
+class FSMAAFusedSharpenDim : SHADER_PERMUTATION_BOOL("SMAA_FUSED_SHARPEN");
+class FSMAAFusedGrainDim : SHADER_PERMUTATION_BOOL("SMAA_FUSED_GRAIN");
+class FSMAAFusedDitherDim : SHADER_PERMUTATION_BOOL("SMAA_FUSED_DITHER");
+class FSMAAFusedColorConversionDim : SHADER_PERMUTATION_INT("SMAA_FUSED_COLOR_CONVERSION", 3);
+
+// Tile size of the static tile reuse hashes (SMAA_REUSE_TILE_SIZE in shaders)
+static constexpr int32 SMAAReuseTileSize = 16;
+
+// Shared compilation environment - enables native FP16 math (SMAA_USE_FP16) where the platform guarantees it
+void ModifySMAACompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment);
+
 /**
  * SMAA Edge Detection Pixel shader
  * First Pass detects edges in the image
@@ -17,6 +47,8 @@ public:
 	DECLARE_GLOBAL_SHADER(FSMAAEdgeDetectionPS);
 	SHADER_USE_PARAMETER_STRUCT(FSMAAEdgeDetectionPS, FGlobalShader );
 
+	using FPermutationDomain = TShaderPermutationDomain<FSMAAMobileDim, FSMAATileReuseDim, FSMAAMaskDim, FSMAAGeometricDim>;
+
 	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
 			//Input Color Texture
 		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, ColorTexture)
@@ -26,10 +58,32 @@ public:
 		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, DepthTexture)
 		SHADER_PARAMETER_SAMPLER(SamplerState, DepthSampler)
 
+			//Tile states for static tile reuse (SMAA_TILE_REUSE only)
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, TileStateTexture)
+
+			//Custom depth/stencil mask (SMAA_MASK only)
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, CustomDepthTexture)
+		SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture2D<uint2>, CustomStencilTexture)
+		SHADER_PARAMETER(uint32, MaskMode)
+		SHADER_PARAMETER(uint32, MaskStencilMask)
+		SHADER_PARAMETER(uint32, bMaskInvert)
+		SHADER_PARAMETER(FVector2f, MaskUVToPixelScale)
+		SHADER_PARAMETER(FVector2f, MaskUVToPixelBias)
+
+			//GBuffer for geometric edge detection (SMAA_GEOMETRIC only)
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, GBufferATexture)
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, GBufferBTexture)
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, SceneDepthTexture)
+		SHADER_PARAMETER(FVector2f, GBufferUVToPixelScale)
+		SHADER_PARAMETER(FVector2f, GBufferUVToPixelBias)
+		SHADER_PARAMETER(float, GeometricNormalThreshold)
+		SHADER_PARAMETER(float, GeometricDepthThreshold)
+
 			//Settings
 		SHADER_PARAMETER(FVector2f, InvTextureSize)
 		SHADER_PARAMETER(float, Threshold)
 		SHADER_PARAMETER(uint32, EdgeDetectionMode)
+		SHADER_PARAMETER(uint32, bHDRInput)
         SHADER_PARAMETER(uint32, DebugMode)
 
 	
@@ -41,18 +95,136 @@ public:
 
 	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
 	{
-		// SM5 and above (DX11+, Vulkan, Metal)
-		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+		// SM5 and above (DX11+, Vulkan, Metal), ES3.1 for the mobile permutation
+		FPermutationDomain PermutationVector(Parameters.PermutationId);
+		if (PermutationVector.Get<FSMAAMobileDim>() && (PermutationVector.Get<FSMAATileReuseDim>() || PermutationVector.Get<FSMAAMaskDim>() || PermutationVector.Get<FSMAAGeometricDim>()))
+		{
+			return false;
+		}
+		return ShouldCompileSMAAPermutation(Parameters, PermutationVector.Get<FSMAAMobileDim>());
 	}
 
 	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
 	{
 		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		ModifySMAACompilationEnvironment(Parameters, OutEnvironment);
 		OutEnvironment.SetDefine(TEXT("SMAA_EDGE_DETECTION"), 1);
 	}
 
 };
 
+/**
+ * SMAA Edge Detection Compute Shader
+ * Luma-only variant of the first pass, each pixel's luma is loaded once into groupshared memory
+ */
+class FSMAAEdgeDetectionCS : public FGlobalShader
+{
+public:
+    DECLARE_GLOBAL_SHADER(FSMAAEdgeDetectionCS);
+    SHADER_USE_PARAMETER_STRUCT(FSMAAEdgeDetectionCS, FGlobalShader);
+
+    static constexpr int32 ThreadGroupSize = 8;
+
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+        // Input Color Texture
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D, ColorTexture)
+
+        // Settings
+        SHADER_PARAMETER(FIntPoint, TextureExtent)
+        SHADER_PARAMETER(float, Threshold)
+        SHADER_PARAMETER(uint32, bHDRInput)
+
+        // Output
+        SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, OutputTexture)
+    END_SHADER_PARAMETER_STRUCT()
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+    }
+
+    static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+    {
+        FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+        ModifySMAACompilationEnvironment(Parameters, OutEnvironment);
+        OutEnvironment.SetDefine(TEXT("SMAA_EDGE_DETECTION"), 1);
+        OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZE"), ThreadGroupSize);
+    }
+};
+
+/**
+ * SMAA Edge Upsample Pixel Shader
+ * Expands a half resolution edge mask to the full resolution edge texture
+ */
+class FSMAAEdgeUpsamplePS : public FGlobalShader
+{
+public:
+    DECLARE_GLOBAL_SHADER(FSMAAEdgeUpsamplePS);
+    SHADER_USE_PARAMETER_STRUCT(FSMAAEdgeUpsamplePS, FGlobalShader);
+
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+        // Half resolution edges from the edge detection pass
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D, EdgeTexture)
+
+        // Output
+        RENDER_TARGET_BINDING_SLOTS()
+    END_SHADER_PARAMETER_STRUCT()
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+    }
+
+    static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+    {
+        FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+        ModifySMAACompilationEnvironment(Parameters, OutEnvironment);
+        OutEnvironment.SetDefine(TEXT("SMAA_EDGE_UPSAMPLE"), 1);
+    }
+};
+
+/**
+ * SMAA Edge Pack Compute Shader
+ * Packs the edge texture into 32 edges per R32_UINT texel for long-range searches
+ */
+class FSMAAEdgePackCS : public FGlobalShader
+{
+public:
+    DECLARE_GLOBAL_SHADER(FSMAAEdgePackCS);
+    SHADER_USE_PARAMETER_STRUCT(FSMAAEdgePackCS, FGlobalShader);
+
+    // One packed word per group row/column
+    static constexpr int32 ThreadGroupSize = 32;
+
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+        // Edge texture from the edge detection pass
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D, EdgeTexture)
+
+        // Settings
+        SHADER_PARAMETER(FIntPoint, TextureExtent)
+
+        // Output
+        SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<uint>, PackedEdgesH)
+        SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<uint>, PackedEdgesV)
+    END_SHADER_PARAMETER_STRUCT()
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+    }
+
+    static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+    {
+        FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+        ModifySMAACompilationEnvironment(Parameters, OutEnvironment);
+        OutEnvironment.SetDefine(TEXT("SMAA_EDGE_PACK"), 1);
+        OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZE"), ThreadGroupSize);
+    }
+};
+
+// Blending weight searches read the packed edge textures instead of SMAA.Edges
+class FSMAAPackedEdgesDim : SHADER_PERMUTATION_BOOL("SMAA_PACKED_EDGES");
+
 /**
  * SMAA Blending Weight Calculation Pixel Shader
  * Second pass - calculates blend weights using area and search textures
@@ -63,11 +235,24 @@ public:
     DECLARE_GLOBAL_SHADER(FSMAABlendingWeightPS);
     SHADER_USE_PARAMETER_STRUCT(FSMAABlendingWeightPS, FGlobalShader);
 
+    using FPermutationDomain = TShaderPermutationDomain<FSMAAPackedEdgesDim, FSMAAMobileDim, FSMAATileReuseDim>;
+
+    // The mobile permutation searches one pixel per step, up to this many steps per direction
+    static constexpr int32 MobileMaxSearchSteps = 8;
+
     BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
         // Edge texture from previous pass
         SHADER_PARAMETER_RDG_TEXTURE(Texture2D, EdgeTexture)
         SHADER_PARAMETER_SAMPLER(SamplerState, EdgeSampler)
 
+        // Packed edges (SMAA_PACKED_EDGES only)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, PackedEdgesH)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, PackedEdgesV)
+
+        // Static tile reuse (SMAA_TILE_REUSE only)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, TileStateTexture)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D, HistoryBlendTexture)
+
         // Precomputed SMAA textures
         SHADER_PARAMETER_RDG_TEXTURE(Texture2D, AreaTexture)
         SHADER_PARAMETER_SAMPLER(SamplerState, AreaSampler)
@@ -86,6 +271,61 @@ public:
         RENDER_TARGET_BINDING_SLOTS()
     END_SHADER_PARAMETER_STRUCT()
 
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        FPermutationDomain PermutationVector(Parameters.PermutationId);
+
+        // The mobile path reads single-channel edges, there is no packed or tile reuse variant
+        if (PermutationVector.Get<FSMAAMobileDim>() && (PermutationVector.Get<FSMAAPackedEdgesDim>() || PermutationVector.Get<FSMAATileReuseDim>()))
+        {
+            return false;
+        }
+        return ShouldCompileSMAAPermutation(Parameters, PermutationVector.Get<FSMAAMobileDim>());
+    }
+
+    static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+    {
+        FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+        ModifySMAACompilationEnvironment(Parameters, OutEnvironment);
+        OutEnvironment.SetDefine(TEXT("SMAA_BLENDING_WEIGHT"), 1);
+    }
+};
+
+/**
+ * SMAA Blending Weight Calculation Compute Shader
+ * Second pass on bit-packed edge tiles in groupshared memory, long lines fall back to texture fetches
+ */
+class FSMAABlendingWeightCS : public FGlobalShader
+{
+public:
+    DECLARE_GLOBAL_SHADER(FSMAABlendingWeightCS);
+    SHADER_USE_PARAMETER_STRUCT(FSMAABlendingWeightCS, FGlobalShader);
+
+    // A tile row plus both aprons is packed into one 32 bit word
+    static constexpr int32 ThreadGroupSize = 16;
+
+    using FPermutationDomain = TShaderPermutationDomain<FSMAAPackedEdgesDim>;
+
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+        // Edge texture from previous pass
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D, EdgeTexture)
+
+        // Packed edges (SMAA_PACKED_EDGES only)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, PackedEdgesH)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, PackedEdgesV)
+
+        // Precomputed SMAA textures
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D, AreaTexture)
+        SHADER_PARAMETER_SAMPLER(SamplerState, AreaSampler)
+
+        // Settings
+        SHADER_PARAMETER(FIntPoint, TextureExtent)
+        SHADER_PARAMETER(int32, MaxSearchSteps)
+
+        // Output
+        SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, OutputTexture)
+    END_SHADER_PARAMETER_STRUCT()
+
     static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
     {
         return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
@@ -94,7 +334,103 @@ public:
     static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
     {
         FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+        ModifySMAACompilationEnvironment(Parameters, OutEnvironment);
         OutEnvironment.SetDefine(TEXT("SMAA_BLENDING_WEIGHT"), 1);
+        OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZE"), ThreadGroupSize);
+    }
+};
+
+/**
+ * SMAA Tile Hash Compute Shader
+ * Hashes scene color (plus the mask selection and geometric edge inputs) per tile and flags tiles that changed since last frame
+ */
+class FSMAATileHashCS : public FGlobalShader
+{
+public:
+    DECLARE_GLOBAL_SHADER(FSMAATileHashCS);
+    SHADER_USE_PARAMETER_STRUCT(FSMAATileHashCS, FGlobalShader);
+
+    using FPermutationDomain = TShaderPermutationDomain<FSMAAMaskDim, FSMAAGeometricDim>;
+
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+        // Input Color Texture
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D, ColorTexture)
+
+        // Mask (SMAA_MASK), same selection as the edge detection pass
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D, CustomDepthTexture)
+        SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture2D<uint2>, CustomStencilTexture)
+        SHADER_PARAMETER(uint32, MaskMode)
+        SHADER_PARAMETER(uint32, MaskStencilMask)
+        SHADER_PARAMETER(uint32, bMaskInvert)
+        SHADER_PARAMETER(FVector2f, MaskUVToPixelScale)
+        SHADER_PARAMETER(FVector2f, MaskUVToPixelBias)
+
+        // GBuffer (SMAA_GEOMETRIC), the inputs of geometric edges
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D, GBufferATexture)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D, GBufferBTexture)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D, SceneDepthTexture)
+        SHADER_PARAMETER(FVector2f, GBufferUVToPixelScale)
+        SHADER_PARAMETER(FVector2f, GBufferUVToPixelBias)
+
+        // Last frame's hashes (only read with bHasHistory)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, PreviousTileHashes)
+
+        // Settings
+        SHADER_PARAMETER(FIntPoint, TextureExtent)
+        SHADER_PARAMETER(uint32, bHasHistory)
+
+        // Output
+        SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<uint>, TileHashes)
+        SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<uint>, TileChangedOutput)
+    END_SHADER_PARAMETER_STRUCT()
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+    }
+
+    static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+    {
+        FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+        ModifySMAACompilationEnvironment(Parameters, OutEnvironment);
+        OutEnvironment.SetDefine(TEXT("SMAA_TILE_HASH"), 1);
+    }
+};
+
+/**
+ * SMAA Tile Classify Compute Shader
+ * Decides per tile whether edges/weights are recomputed or last frame's weights are reused
+ */
+class FSMAATileClassifyCS : public FGlobalShader
+{
+public:
+    DECLARE_GLOBAL_SHADER(FSMAATileClassifyCS);
+    SHADER_USE_PARAMETER_STRUCT(FSMAATileClassifyCS, FGlobalShader);
+
+    static constexpr int32 ThreadGroupSize = 8;
+
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+        // Changed flags from the hash pass
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, TileChanged)
+
+        // Settings
+        SHADER_PARAMETER(FIntPoint, TileCount)
+        SHADER_PARAMETER(int32, ReuseRadius)
+
+        // Output
+        SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<uint>, TileState)
+    END_SHADER_PARAMETER_STRUCT()
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+    }
+
+    static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+    {
+        FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+        ModifySMAACompilationEnvironment(Parameters, OutEnvironment);
+        OutEnvironment.SetDefine(TEXT("SMAA_TILE_CLASSIFY"), 1);
     }
 };
 
@@ -108,6 +444,8 @@ public:
     DECLARE_GLOBAL_SHADER(FSMAANeighborhoodBlendingPS);
     SHADER_USE_PARAMETER_STRUCT(FSMAANeighborhoodBlendingPS, FGlobalShader);
 
+    using FPermutationDomain = TShaderPermutationDomain<FSMAAMobileDim, FSMAAFusedSharpenDim, FSMAAFusedGrainDim, FSMAAFusedDitherDim, FSMAAFusedColorConversionDim>;
+
     BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
         // Original color texture
         SHADER_PARAMETER_RDG_TEXTURE(Texture2D, ColorTexture)
@@ -121,6 +459,72 @@ public:
         SHADER_PARAMETER(FVector2f, InvTextureSize)
         SHADER_PARAMETER(uint32, DebugMode)
 
+        // Fused post stages
+        SHADER_PARAMETER(float, SharpenAmount)
+        SHADER_PARAMETER(float, GrainIntensity)
+        SHADER_PARAMETER(uint32, FrameIndex)
+
+
+        // Output
+        RENDER_TARGET_BINDING_SLOTS()
+    END_SHADER_PARAMETER_STRUCT()
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        FPermutationDomain PermutationVector(Parameters.PermutationId);
+
+        // The mobile path keeps the plain blend, fused stages are desktop only
+        const bool bFused = PermutationVector.Get<FSMAAFusedSharpenDim>()
+            || PermutationVector.Get<FSMAAFusedGrainDim>()
+            || PermutationVector.Get<FSMAAFusedDitherDim>()
+            || PermutationVector.Get<FSMAAFusedColorConversionDim>() != 0;
+        if (PermutationVector.Get<FSMAAMobileDim>() && bFused)
+        {
+            return false;
+        }
+        return ShouldCompileSMAAPermutation(Parameters, PermutationVector.Get<FSMAAMobileDim>());
+    }
+
+    static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+    {
+        FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+        ModifySMAACompilationEnvironment(Parameters, OutEnvironment);
+        OutEnvironment.SetDefine(TEXT("SMAA_NEIGHBORHOOD_BLENDING"), 1);
+    }
+};
+
+/**
+ * SMAA Neighborhood Blending + Upscale Pixel Shader
+ * Third pass writing straight to the upscaled output, replaces the engine's spatial upscale
+ */
+class FSMAANeighborhoodUpscalePS : public FGlobalShader
+{
+public:
+    DECLARE_GLOBAL_SHADER(FSMAANeighborhoodUpscalePS);
+    SHADER_USE_PARAMETER_STRUCT(FSMAANeighborhoodUpscalePS, FGlobalShader);
+
+    using FPermutationDomain = TShaderPermutationDomain<FSMAAFusedSharpenDim, FSMAAFusedGrainDim, FSMAAFusedDitherDim, FSMAAFusedColorConversionDim>;
+
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+        // Render resolution color texture
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D, ColorTexture)
+        SHADER_PARAMETER_SAMPLER(SamplerState, ColorSampler)
+
+        // Blend weight texture from previous pass (render resolution)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D, BlendTexture)
+        SHADER_PARAMETER_SAMPLER(SamplerState, BlendSampler)
+
+        // Settings
+        SHADER_PARAMETER(FVector2f, InvTextureSize)
+        SHADER_PARAMETER(FVector2f, OutputViewMin)
+        SHADER_PARAMETER(FVector2f, OutputToInputScale)
+        SHADER_PARAMETER(FVector2f, InputViewMin)
+        SHADER_PARAMETER(FVector2f, InputViewMax)
+
+        // Fused post stages
+        SHADER_PARAMETER(float, SharpenAmount)
+        SHADER_PARAMETER(float, GrainIntensity)
+        SHADER_PARAMETER(uint32, FrameIndex)
 
         // Output
         RENDER_TARGET_BINDING_SLOTS()
@@ -134,6 +538,8 @@ public:
     static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
     {
         FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+        ModifySMAACompilationEnvironment(Parameters, OutEnvironment);
         OutEnvironment.SetDefine(TEXT("SMAA_NEIGHBORHOOD_BLENDING"), 1);
+        OutEnvironment.SetDefine(TEXT("SMAA_UPSCALE"), 1);
     }
-};
\ No newline at end of file
+};
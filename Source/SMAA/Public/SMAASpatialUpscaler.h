@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PostProcess/PostProcessUpscale.h"
+#include "SMAASettings.h"
+
+/**
+ * SMAA-aware primary spatial upscaler (r.SMAA.Upscale)
+ *
+ * With a screen percentage below 100 and no temporal upscaler, SMAA computes its weights at
+ * render resolution and this upscaler runs neighborhood blending straight into the output
+ * resolution. That replaces the engine's upscale pass and avoids anti-aliasing the larger image.
+ */
+class FSMAASpatialUpscaler final : public UE::Renderer::Private::ISpatialUpscaler
+{
+public:
+	static const TCHAR* const DebugName;
+
+	//ISpatialUpscaler interface
+	virtual const TCHAR* GetDebugName() const override { return DebugName; }
+	virtual UE::Renderer::Private::ISpatialUpscaler* Fork_GameThread(const FSceneViewFamily& ViewFamily) const override;
+	virtual FScreenPassTexture AddPasses(FRDGBuilder& GraphBuilder, const FViewInfo& View, const FInputs& PassInputs) const override;
+
+	/**
+	 * Hands the render resolution weights of a view to the upscale pass (render thread)
+	 */
+	void SetBlendWeights(const FViewInfo& View, FRDGTextureRef BlendWeights, const FSMAASettings& Settings) const;
+
+	/**
+	 * The view family's primary spatial upscaler if it is the SMAA one
+	 */
+	static const FSMAASpatialUpscaler* Find(const FSceneViewFamily& ViewFamily);
+
+private:
+	struct FViewInputs
+	{
+		FRDGTextureRef BlendWeights = nullptr;
+		FSMAASettings Settings;
+	};
+
+	// Filled by the SMAA post process callback and consumed by AddPasses within the same graph
+	mutable TMap<const FViewInfo*, FViewInputs> ViewInputs;
+};
@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/BlendableInterface.h"
+#include "Engine/DataAsset.h"
+#include "SMAASettings.h"
+#include "SMAAViewSettings.generated.h"
+
+class FSceneView;
+
+/**
+ * Per-view SMAA overrides, resolved from post process volumes and cameras
+ *
+ * Add it to the Blendables of a post process volume, camera or scene capture
+ * (as an asset or inline object). Only the settings with their override flag set
+ * replace the r.SMAA.* console variables, so e.g. the primary view can run Ultra
+ * while picture-in-picture views and cinematic regions run Low.
+ */
+UCLASS(BlueprintType, EditInlineNew)
+class SMAA_API USMAAViewSettings : public UDataAsset, public IBlendableInterface
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SMAA", meta = (InlineEditConditionToggle))
+	uint8 bOverride_bEnabled : 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SMAA", meta = (InlineEditConditionToggle))
+	uint8 bOverride_QualityPreset : 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SMAA", meta = (InlineEditConditionToggle))
+	uint8 bOverride_EdgeDetectionThreshold : 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SMAA", meta = (InlineEditConditionToggle))
+	uint8 bOverride_MaxSearchSteps : 1;
+
+	// Switches SMAA off for the view (turning it on still requires r.SMAA.Enable 1)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SMAA", meta = (EditCondition = "bOverride_bEnabled"))
+	bool bEnabled = true;
+
+	// Quality preset of the view, replaces r.SMAA.Quality
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SMAA", meta = (EditCondition = "bOverride_QualityPreset"))
+	ESMAAQualityPreset QualityPreset = ESMAAQualityPreset::High;
+
+	// Edge detection threshold of the view, replaces r.SMAA.Threshold
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SMAA", meta = (EditCondition = "bOverride_EdgeDetectionThreshold", ClampMin = "0.01", ClampMax = "0.5"))
+	float EdgeDetectionThreshold = 0.1f;
+
+	// Maximum search steps of the view, replaces r.SMAA.MaxSearchSteps and the preset's steps
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SMAA", meta = (EditCondition = "bOverride_MaxSearchSteps", ClampMin = "0", ClampMax = "112"))
+	int32 MaxSearchSteps = 32;
+
+	USMAAViewSettings();
+
+	//IBlendableInterface interface
+	virtual void OverrideBlendableSettings(FSceneView& View, float Weight) const override;
+};
+
+/**
+ * Resolves the blended USMAAViewSettings of a view
+ */
+namespace SMAAViewSettings
+{
+	// Applies the view's overrides on top of the console variable settings (any thread, reads the data copied at blend time)
+	void ApplyOverrides(const FSceneView& View, FSMAASettings& InOutSettings);
+}
@@ -42,6 +42,7 @@ public class SMAA : ModuleRules
                 "Renderer",        // For FSceneViewExtension, RDG, PostProcess
                 "RHI",            // For RHI command lists, resources
                 "Projects",       // For IPluginManager (shader path mapping)
+                "ImageCore",      // For FImage (offline batch commandlet)
 			}
 			);
 		